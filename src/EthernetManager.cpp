@@ -5,11 +5,8 @@
 #include <esp_eth.h>
 #include <esp_event.h>
 #include <esp_netif.h>
-
-// Fallback for missing macro in older ESP32 Arduino cores
-#ifndef IP_EVENT_GOT_IP
-#define IP_EVENT_GOT_IP 4
-#endif
+#include <esp_system.h>
+#include <esp_timer.h>
 
 // Constructor for singleton
 EthernetManager::EthernetManager() {
@@ -36,8 +33,14 @@ EthernetManager::~EthernetManager() {
     }
 }
 
-EthResult<void> EthernetManager::initialize(const EthernetConfig& config) {
-    auto& inst = getInstance();
+// Feature setup shared by initialize() and initializeAsync(); runs before
+// the driver is installed so every option is in place for the first event
+void EthernetManager::applyConfig(const EthernetConfig& config) {
+    // Handlers move to the private loop before earlyInit() registers them
+    if (config.private_event_loop) {
+        setPrivateEventLoop(true, config.event_loop_priority, config.event_loop_core,
+                            config.event_loop_queue);
+    }
 
     // Apply configuration settings
     if (config.custom_mac) {
@@ -49,16 +52,111 @@ EthResult<void> EthernetManager::initialize(const EthernetConfig& config) {
         setAutoReconnect(true, config.reconnect_max_retries,
                         config.reconnect_initial_delay, config.reconnect_max_delay);
     }
+    if (config.backoff_policy_set) {
+        setReconnectBackoff(config.backoff_policy);
+    }
+
+    if (config.link_hold_grace_set) {
+        setLinkHoldGrace(config.link_hold_grace);
+    }
+    if (config.static_fast_path_set) {
+        setStaticFastPath(config.static_fast_path);
+    }
+    if (config.warm_start) {
+        setWarmStart(true);
+    }
+    if (config.phy_power_save_set) {
+        setPhyPowerPolicy(config.phy_eee, config.phy_energy_detect);
+    }
+    if (config.wake_on_lan) {
+        setWakeOnLan(true, config.wol_wake_pin);
+    }
+    if (config.multicast_filter_set) {
+        setMulticastFilter(config.multicast_filter);
+    }
+    if (config.storm_shedding) {
+        setStormShedding(config.storm_broadcast_pps, config.storm_multicast_pps,
+                         config.storm_drop_foreign_arp);
+    }
+    if (config.traffic_shaper) {
+        setShaperLinkRate(config.shaper_link_kbps);
+        setTrafficShaper(true);
+    }
+    if (config.vlan_id) {
+        setVlan(config.vlan_id);
+    }
+    for (uint8_t i = 0; i < config.virtual_vlan_count; i++) {
+        addVlanInterface(config.virtual_vlans[i]);
+    }
+    if (config.abort_sockets_set) {
+        setSocketAbortOnDisconnect(config.abort_sockets);
+    }
+    if (config.flap_damping_set) {
+        setFlapDamping(config.flap_damping, config.flap_half_life, config.flap_suppress, config.flap_reuse);
+    }
+    if (config.dhcp_watchdog_set) {
+        setDhcpWatchdog(config.dhcp_watchdog_timeout);
+    }
+
+    // Fallback chain must be armed before the first link up
+    if (config.dhcp_fallback_timeout > 0) {
+        setDhcpFallback(config.dhcp_fallback_timeout, config.fallback_autoip, config.dhcp_retry_interval,
+                        config.fallback_ip, config.fallback_gateway, config.fallback_subnet,
+                        config.fallback_dns);
+    }
+
+    // Health monitor idles until CONNECTED
+    if (config.enable_health_monitor) {
+        enableHealthMonitor(config.health_interval, config.health_target, config.health_fast_interval);
+    }
+
+    // ARP prewarm applies from the first GOT_IP
+    if (config.arp_prewarm_set) {
+        setArpPrewarm(config.gratuitous_arp, config.arp_resolve_gateway);
+    }
+    for (uint8_t i = 0; i < config.arp_peer_count; i++) {
+        addArpPeer(config.arp_peers[i]);
+    }
+
+    // Lease cache must be loaded before the first link up
+    if (config.enable_lease_cache) {
+        setDhcpLeaseCache(true);
+    }
+
+    // IPv6 must be configured before the first link up
+    if (config.enable_ipv6) {
+        setIPv6(true, config.ready_policy);
+    }
+
+    // Start the standby WiFi uplink before Ethernet so a cable-less boot is covered
+    if (config.failover_ssid) {
+        enableFailover(config.failover_ssid, config.failover_password,
+                       config.failover_mode, config.failover_return_stable_ms);
+    }
+}
+
+EthResult<void> EthernetManager::initialize(const EthernetConfig& config) {
+    auto& inst = getInstance();
+
+    applyConfig(config);
+
+    // Resolve the PHY address on the MDIO bus before the driver is installed;
+    // a deep-sleep snapshot already carries it
+    EthernetConfig resolved = config;
+    bool resumed = inst.restoreSleepSnapshot(resolved);
+    if (config.phy_auto_detect && !resumed && !detectPhy(resolved)) {
+        ETH_LOG_W("PHY discovery failed, trying configured address %d", config.phy_addr);
+    }
 
     // Initialize based on IP configuration
     EthResult<void> result;
     if (config.use_static_ip) {
         result = initializeStatic(config.hostname, config.static_ip, config.gateway,
                                  config.subnet, config.primary_dns, config.secondary_dns,
-                                 config.phy_addr, config.mdc_pin, config.mdio_pin,
+                                 resolved.phy_addr, config.mdc_pin, config.mdio_pin,
                                  config.power_pin, config.clock_mode);
     } else {
-        bool success = inst.internalInit(config.hostname, config.phy_addr, config.mdc_pin,
+        bool success = inst.internalInit(config.hostname, resolved.phy_addr, config.mdc_pin,
                             config.mdio_pin, config.power_pin, config.clock_mode,
                             config.custom_mac, true);
         result = success ? EthResult<void>::ok() : EthResult<void>(inst.lastError);
@@ -75,15 +173,14 @@ EthResult<void> EthernetManager::initialize(const EthernetConfig& config) {
 EthResult<void> EthernetManager::initializeAsync(const EthernetConfig& config) {
     auto& inst = getInstance();
 
-    // Apply configuration settings
-    if (config.custom_mac) {
-        setMacAddress(config.custom_mac);
-    }
+    applyConfig(config);
 
-    // Configure auto-reconnect if enabled
-    if (config.enable_auto_reconnect) {
-        setAutoReconnect(true, config.reconnect_max_retries,
-                        config.reconnect_initial_delay, config.reconnect_max_delay);
+    // Resolve the PHY address on the MDIO bus before the driver is installed;
+    // a deep-sleep snapshot already carries it
+    EthernetConfig resolved = config;
+    bool resumed = inst.restoreSleepSnapshot(resolved);
+    if (config.phy_auto_detect && !resumed && !detectPhy(resolved)) {
+        ETH_LOG_W("PHY discovery failed, trying configured address %d", config.phy_addr);
     }
 
     bool result;
@@ -94,11 +191,11 @@ EthResult<void> EthernetManager::initializeAsync(const EthernetConfig& config) {
         ETH_LOG_I("Using static IP configuration from EthernetConfig");
         result = inst.internalInitStatic(config.hostname, config.static_ip, config.gateway,
                                    config.subnet, config.primary_dns, config.secondary_dns,
-                                   config.phy_addr, config.mdc_pin, config.mdio_pin,
+                                   resolved.phy_addr, config.mdc_pin, config.mdio_pin,
                                    config.power_pin, config.clock_mode);
     } else {
         // Use DHCP (async) initialization
-        result = inst.internalInit(config.hostname, config.phy_addr, config.mdc_pin,
+        result = inst.internalInit(config.hostname, resolved.phy_addr, config.mdc_pin,
                              config.mdio_pin, config.power_pin, config.clock_mode,
                              config.custom_mac, false);
     }
@@ -185,23 +282,11 @@ bool EthernetManager::earlyInit() {
 
     // Register event handlers early to catch all events
     if (!inst.eventHandlersRegistered) {
-        // Use ESP_EVENT_ANY_BASE instead of specific bases for early registration
-        err = esp_event_handler_register(IP_EVENT, ESP_EVENT_ANY_ID, onEthEvent, nullptr);
+        // Default loop, or a forwarder into the private loop (setPrivateEventLoop())
+        err = inst.registerEventHandlers();
         if (err != ESP_OK) {
-            ETH_LOG_E("Failed to register IP event handler: %d", err);
-            // Clean up event group if we created it
-            if (inst.ethEventGroup) {
-                vEventGroupDelete(inst.ethEventGroup);
-                inst.ethEventGroup = nullptr;
-            }
-            return false;  // MutexGuard auto-releases on return
-        }
-
-        err = esp_event_handler_register(ETH_EVENT, ESP_EVENT_ANY_ID, onEthEvent, nullptr);
-        if (err != ESP_OK) {
-            ETH_LOG_E("Failed to register ETH event handler: %d", err);
-            // Unregister IP event handler
-            esp_event_handler_unregister(IP_EVENT, ESP_EVENT_ANY_ID, onEthEvent);
+            ETH_LOG_E("Failed to register event handlers: %d", err);
+            inst.lastError = EthError::EVENT_HANDLER_FAILED;
             // Clean up event group if we created it
             if (inst.ethEventGroup) {
                 vEventGroupDelete(inst.ethEventGroup);
@@ -285,76 +370,52 @@ bool EthernetManager::internalInit(const char* hostname, int8_t phy_addr, int8_t
             return false;
         }
 
-        xEventGroupClearBits(ethEventGroup, BIT_CONNECTED);
+        clearAddresses();
+        staticIpMode = false;
 
-        // Set custom MAC if provided before ETH.begin
+        // Kept for driver/netif recreation by the recovery ladder
+        strlcpy(beginHostname, hostname, sizeof(beginHostname));
+        beginPhyAddr = phy_addr;
+        beginMdcPin = mdc_pin;
+        beginMdioPin = mdio_pin;
+        beginPowerPin = power_pin;
+        beginClockMode = clock_mode;
+
+        // Set custom MAC if provided before the driver starts
         if (customMac) {
             memcpy(customMacAddress, customMac, ETH_MAC_ADDRESS_SIZE);
             hasCustomMac = true;
         }
 
-        ETH_LOG_D("Starting ETH.begin at %lu ms", millis() - startTime);
+        // After esp_restart() the PHY may still hold its link
+        prepareWarmBoot();
+
+        ETH_LOG_D("Starting %s at %lu ms", EthBackend::NAME, millis() - startTime);
 
         // Update state to PHY starting
         changeState(EthConnectionState::PHY_STARTING);
 
-        // Start Ethernet PHY with optimized initialization
-        bool success = false;
-
-#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
-        // Arduino 3.x+ version
-
-        // Pre-configure hostname to avoid multiple sets
-        if (hostname) {
-            ETH.setHostname(hostname);
-        }
-
-        // Start Ethernet with all parameters at once
-        success = ETH.begin(ETH_PHY_LAN8720, phy_addr, mdc_pin, mdio_pin, power_pin, clock_mode);
-
+        // Start Ethernet PHY through the selected backend
+        bool success = EthBackend::begin(backendConfig());
+        keepPhyState = false;  // Recovery restarts are always cold
         if (success && hasCustomMac) {
-            // Apply custom MAC if needed
-            if (!ETH.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, customMacAddress)) {
-                ETH_LOG_W("Failed to set custom MAC address");
-                // Continue anyway - not a critical failure
-            } else {
-                ETH_LOG_I("Custom MAC set: %02X:%02X:%02X:%02X:%02X:%02X",
-                            customMacAddress[0], customMacAddress[1], customMacAddress[2],
-                            customMacAddress[3], customMacAddress[4], customMacAddress[5]);
-            }
+            ETH_LOG_I("Custom MAC set: %02X:%02X:%02X:%02X:%02X:%02X",
+                        customMacAddress[0], customMacAddress[1], customMacAddress[2],
+                        customMacAddress[3], customMacAddress[4], customMacAddress[5]);
         }
-#else
-        // Arduino 2.x version
-        success = ETH.begin(power_pin, mdc_pin, mdio_pin, phy_addr, ETH_PHY_LAN8720, clock_mode);
-
-        if (success && hostname) {
-            ETH.setHostname(hostname);
-
-            if (customMac) {
-                if (!ETH.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, customMac)) {
-                    ETH_LOG_W("Failed to set custom MAC address");
-                    // Continue anyway - not a critical failure
-                } else {
-                    ETH_LOG_I("Custom MAC set: %02X:%02X:%02X:%02X:%02X:%02X",
-                                customMac[0], customMac[1], customMac[2],
-                                customMac[3], customMac[4], customMac[5]);
-                }
-            }
-        }
-#endif
 
         if (!success) {
-            ETH_LOG_E("ETH.begin failed after %lu ms", millis() - startTime);
+            ETH_LOG_E("%s start failed after %lu ms", EthBackend::NAME, millis() - startTime);
             lastError = EthError::PHY_START_FAILED;
             changeState(EthConnectionState::ERROR_STATE);
             return false;  // MutexGuard auto-releases
         }
 
         phyStarted = true;
-        ETH_LOG_D("ETH.begin completed after %lu ms", millis() - startTime);
+        ETH_LOG_D("%s started after %lu ms", EthBackend::NAME, millis() - startTime);
 
         // Store netif handle for later use
-        eth_netif = esp_netif_get_handle_from_ifkey("ETH_DEF");
+        eth_netif = EthBackend::netif();
         if (eth_netif) {
             netifCreated = true;
 
@@ -379,9 +440,15 @@ bool EthernetManager::internalInit(const char* hostname, int8_t phy_addr, int8_t
         }
     }  // MutexGuard released here before long wait
 
-    // Wait for connection (outside mutex to not block other operations)
+    // Wait for connection (outside mutex to not block other operations);
+    // with a DHCP fallback configured the bound includes the fallback chain
     ETH_LOG_D("Waiting for connection...");
-    if (!waitForConnection(ETH_INIT_TIMEOUT_MS)) {
+    uint32_t waitMs = ETH_INIT_TIMEOUT_MS;
+    if (dhcpFallbackTimeout > 0) {
+        waitMs += dhcpFallbackTimeout +
+                  (ETH_AUTOIP_MAX_CONFLICTS + 1) * ETH_ARP_PROBE_COUNT * ETH_ARP_PROBE_WAIT_MS;
+    }
+    if (!waitForConnection(waitMs)) {
         ETH_LOG_E("Ethernet connection timeout after %lu ms", millis() - startTime);
         return false;
     }
@@ -395,6 +462,26 @@ void EthernetManager::cleanup() {
     ETH_LOG_D("Cleaning up Ethernet Manager");
     auto& inst = getInstance();
 
+    // The benchmark task uses the netif and the event group; it ends within a socket timeout
+    stopBenchmark();
+    waitForBenchmark(ETH_MUTEX_STANDARD_TIMEOUT_MS);
+
+    // A recovery action holds the driver and the fallback task probes
+    // through it; let both finish before tearing down
+    inst.stopRecovery();
+    inst.stopFallback();
+
+    // Takes the mutex itself; stops the standby station it started
+    disableFailover();
+
+    // Reports UNKNOWN through the health callback, which must not run under the mutex
+    disableHealthMonitor();
+
+    // Leave SUSPENDED (state callbacks) before the receive hook is removed below
+    if (inst.wolEnabled) {
+        setWakeOnLan(false);
+    }
+
     // Take mutex for cleanup
     MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
     if (!guard) {
@@ -404,10 +491,13 @@ void EthernetManager::cleanup() {
 
     // Unregister event handlers if registered
     if (inst.eventHandlersRegistered) {
-        esp_event_handler_unregister(IP_EVENT, ESP_EVENT_ANY_ID, onEthEvent);
-        esp_event_handler_unregister(ETH_EVENT, ESP_EVENT_ANY_ID, onEthEvent);
+        inst.unregisterEventHandlers();
         inst.eventHandlersRegistered = false;
     }
+    if (inst.privateLoop) {
+        esp_event_loop_delete(inst.privateLoop);
+        inst.privateLoop = nullptr;
+    }
 
     inst.phyStarted = false;
     inst.gotIpAtLeastOnce = false;
@@ -416,6 +506,9 @@ void EthernetManager::cleanup() {
     inst.eth_netif = nullptr;
     inst.lastGotIpTime = 0;
     inst.connectionStartTime = 0;
+    inst.ipv6Enabled = false;
+    inst.readyPolicy = EthIpReadyPolicy::IPV4;
+    memset(inst.ip6Valid, 0, sizeof(inst.ip6Valid));
 
     if (inst.ethEventGroup) {
         vEventGroupDelete(inst.ethEventGroup);
@@ -434,11 +527,73 @@ void EthernetManager::cleanup() {
         inst.linkMonitorTimer = nullptr;
     }
 
+    if (inst.failbackTimer) {
+        xTimerDelete(inst.failbackTimer, 0);
+        inst.failbackTimer = nullptr;
+    }
+
+    if (inst.leaseSeedTimer) {
+        xTimerDelete(inst.leaseSeedTimer, 0);
+        inst.leaseSeedTimer = nullptr;
+    }
+
+    if (inst.dhcpFallbackTimer) {
+        xTimerDelete(inst.dhcpFallbackTimer, 0);
+        inst.dhcpFallbackTimer = nullptr;
+    }
+
+    if (inst.arpPrewarmTimer) {
+        xTimerDelete(inst.arpPrewarmTimer, 0);
+        inst.arpPrewarmTimer = nullptr;
+    }
+
+    if (inst.flapReuseTimer) {
+        xTimerDelete(inst.flapReuseTimer, 0);
+        inst.flapReuseTimer = nullptr;
+    }
+
+    if (inst.holdGraceTimer) {
+        xTimerDelete(inst.holdGraceTimer, 0);
+        inst.holdGraceTimer = nullptr;
+    }
+    inst.holdRestorePending = false;
+    inst.holdConfirmPending = false;
+    memset(&inst.heldLease, 0, sizeof(inst.heldLease));
+
+    if (inst.dhcpWatchdogTimer) {
+        xTimerDelete(inst.dhcpWatchdogTimer, 0);
+        inst.dhcpWatchdogTimer = nullptr;
+    }
+    inst.dhcpWatchdogLevel = 0;
+    inst.linkSuppressed = false;
+    inst.flapPenalty = 0.0f;
+    inst.arpPeerCount = 0;
+    inst.dhcpFallbackTimeout = 0;
+    inst.fallbackActive = false;
+    inst.staticIpMode = false;
+    inst.detachEgressHook();  // Before the VLAN state it tags with goes away
+    inst.shaperEnabled = false;
+    inst.destroyVlanInterfaces();
+    inst.removeStackInput();  // The driver outlives cleanup(); give frames back to the glue
+    inst.wolArmed = false;
+    inst.wolMatched = false;
+    inst.wolStats = {};
+    inst.wolFramesDropped = 0;
+    inst.ethHandle = nullptr;
+    inst.lastRecoveryAction = EthRecoveryAction::NONE;
+    inst.leaseCacheEnabled = false;
+    inst.leaseRebooted = false;
+    inst.failoverEnabled = false;
+    inst.failoverPending = false;
+    inst.activeUplink = EthUplink::NONE;
+    memset(&inst.failoverStats, 0, sizeof(inst.failoverStats));
+
     // Clear callbacks
     inst.connectedCallback = nullptr;
     inst.disconnectedCallback = nullptr;
     inst.stateChangeCallback = nullptr;
     inst.linkStatusCallback = nullptr;
+    inst.healthCallback = nullptr;
 
     // Reset state
     inst.connectionState = EthConnectionState::UNINITIALIZED;
@@ -482,7 +637,7 @@ void EthernetManager::disconnect() {
         inst.changeState(EthConnectionState::DISCONNECTING);
 
         // Stop the PHY if it was started
-        if (inst.phyStarted && ETH.linkUp()) {
+        if (inst.phyStarted && EthBackend::linkUp()) {
             ETH_LOG_D("Stopping Ethernet PHY...");
             // Note: ESP32 Arduino ETH doesn't have a stop() method, but we can simulate disconnect
             // by disabling auto-reconnect and clearing state
@@ -650,71 +805,41 @@ bool EthernetManager::internalInitStatic(const char* hostname, IPAddress local_i
             return false;
         }
 
-        xEventGroupClearBits(ethEventGroup, BIT_CONNECTED);
-
-        ETH_LOG_D("Starting ETH.begin with static IP at %lu ms", millis() - startTime);
-
-        // Start Ethernet PHY
-        bool success = false;
-
-#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
-        // Arduino 3.x+ version
-        // Pre-configure hostname
-        if (hostname) {
-            ETH.setHostname(hostname);
-        }
-
-        // Start Ethernet
-        success = ETH.begin(ETH_PHY_LAN8720, phy_addr, mdc_pin, mdio_pin, power_pin, clock_mode);
-
-        if (success) {
-            // Configure static IP with optional custom MAC
-            if (hasCustomMac) {
-                success = ETH.config(local_ip, gateway, subnet, dns1, dns2, customMacAddress);
-            } else {
-                success = ETH.config(local_ip, gateway, subnet, dns1, dns2);
-            }
-
-            if (!success) {
-                ETH_LOG_E("Failed to configure static IP");
-            } else {
-                ETH_LOG_I("Static IP configured: %s", local_ip.toString().c_str());
-            }
-        }
-#else
-        // Arduino 2.x version
-        success = ETH.begin(power_pin, mdc_pin, mdio_pin, phy_addr, ETH_PHY_LAN8720, clock_mode);
-
-        if (success) {
-            if (hostname) {
-                ETH.setHostname(hostname);
-            }
-
-            // Configure static IP
-            if (hasCustomMac) {
-                success = ETH.config(local_ip, gateway, subnet, dns1, customMacAddress);
-            } else {
-                success = ETH.config(local_ip, gateway, subnet, dns1);
-            }
-
-            if (!success) {
-                ETH_LOG_E("Failed to configure static IP");
-            } else {
-                ETH_LOG_I("Static IP configured: %s", local_ip.toString().c_str());
-            }
-        }
-#endif
-
+        clearAddresses();
+        staticIpMode = true;
+
+        // Kept for driver/netif recreation by the recovery ladder
+        strlcpy(beginHostname, hostname, sizeof(beginHostname));
+        beginPhyAddr = phy_addr;
+        beginMdcPin = mdc_pin;
+        beginMdioPin = mdio_pin;
+        beginPowerPin = power_pin;
+        beginClockMode = clock_mode;
+        staticIp = local_ip;
+        staticGateway = gateway;
+        staticSubnet = subnet;
+        staticDns1 = dns1;
+        staticDns2 = dns2;
+
+        // After esp_restart() the PHY may still hold its link
+        prepareWarmBoot();
+
+        ETH_LOG_D("Starting %s with static IP at %lu ms", EthBackend::NAME, millis() - startTime);
+
+        // Start Ethernet PHY with the static address applied by the backend
+        bool success = EthBackend::begin(backendConfig());
+        keepPhyState = false;  // Recovery restarts are always cold
         if (!success) {
-            ETH_LOG_E("ETH.begin or static config failed after %lu ms", millis() - startTime);
+            ETH_LOG_E("%s start or static config failed after %lu ms", EthBackend::NAME, millis() - startTime);
             return false;  // MutexGuard auto-releases
         }
+        ETH_LOG_I("Static IP configured: %s", local_ip.toString().c_str());
 
         phyStarted = true;
-        ETH_LOG_D("ETH.begin with static IP completed after %lu ms", millis() - startTime);
+        ETH_LOG_D("%s with static IP started after %lu ms", EthBackend::NAME, millis() - startTime);
 
         // Store netif handle for later use
-        eth_netif = esp_netif_get_handle_from_ifkey("ETH_DEF");
+        eth_netif = EthBackend::netif();
         if (eth_netif) {
             netifCreated = true;
         }
@@ -780,19 +905,29 @@ void EthernetManager::logEthernetStatus() {
     if (inst.verboseLogging) {
         // Verbose mode: detailed multi-line output
         ETH_LOG_I("Ethernet Status:");
-        ETH_LOG_I("  IP     : %s", ETH.localIP().toString().c_str());
-        ETH_LOG_I("  MAC    : %s", ETH.macAddress().c_str());
-        ETH_LOG_I("  Host   : %s", ETH.getHostname());
-        ETH_LOG_I("  Speed  : %d Mbps", ETH.linkSpeed());
-        ETH_LOG_I("  Duplex : %s", ETH.fullDuplex() ? "FULL" : "HALF");
+        ETH_LOG_I("  IP     : %s", EthBackend::localIP().toString().c_str());
+        ETH_LOG_I("  MAC    : %s", EthBackend::macAddress().c_str());
+        ETH_LOG_I("  Host   : %s", EthBackend::hostname());
+        ETH_LOG_I("  Speed  : %d Mbps", EthBackend::linkSpeed());
+        ETH_LOG_I("  Duplex : %s", EthBackend::fullDuplex() ? "FULL" : "HALF");
+        for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES; i++) {
+            if (inst.ip6Valid[i]) {
+                ETH_LOG_I("  IPv6   : " IPV6STR, IPV62STR(inst.ip6Addrs[i]));
+            }
+        }
     } else {
         // Compact mode: single line summary at INFO level
         ETH_LOG_I("Connected: IP=%s, Link=%dMbps/%s",
-                  ETH.localIP().toString().c_str(),
-                  ETH.linkSpeed(),
-                  ETH.fullDuplex() ? "Full" : "Half");
+                  EthBackend::localIP().toString().c_str(),
+                  EthBackend::linkSpeed(),
+                  EthBackend::fullDuplex() ? "Full" : "Half");
         // Additional details at DEBUG level
-        ETH_LOG_D("MAC=%s, Host=%s", ETH.macAddress().c_str(), ETH.getHostname());
+        ETH_LOG_D("MAC=%s, Host=%s", EthBackend::macAddress().c_str(), EthBackend::hostname());
+        for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES; i++) {
+            if (inst.ip6Valid[i]) {
+                ETH_LOG_D("IPv6[%u]=" IPV6STR, i, IPV62STR(inst.ip6Addrs[i]));
+            }
+        }
     }
 }
 
@@ -837,6 +972,10 @@ NetworkStats EthernetManager::getStatistics() {
         if (isConnected() && inst.stats.connectTime > 0) {
             currentStats.uptimeMs = millis() - inst.stats.connectTime;
         }
+        currentStats.ipv6Addresses = 0;
+        for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES; i++) {
+            if (inst.ip6Valid[i]) currentStats.ipv6Addresses++;
+        }
     }
     return currentStats;
 }
@@ -897,6 +1036,8 @@ const char* EthernetManager::stateToString(EthConnectionState state) {
         case EthConnectionState::CONNECTED: return "Connected";
         case EthConnectionState::DISCONNECTING: return "Disconnecting";
         case EthConnectionState::ERROR_STATE: return "Error";
+        case EthConnectionState::LINK_DOWN_HOLDING: return "Link Down (holding)";
+        case EthConnectionState::SUSPENDED: return "Suspended";
         default: return "Unknown";
     }
 }
@@ -913,21 +1054,85 @@ void EthernetManager::dumpDiagnostics(Print* output) {
     output->println(stateToString(inst.previousState));
     output->print("PHY Started: ");
     output->println(inst.phyStarted ? "Yes" : "No");
+    output->print("Backend: ");
+    output->println(EthBackend::NAME);
+    if (inst.phyInfo.address >= 0) {
+        output->printf("PHY: %s at address %d (%s in %u us)\n", inst.phyInfo.model, inst.phyInfo.address,
+                       inst.phyInfo.fromCache ? "cached" : "scanned", inst.phyInfo.scanTimeUs);
+    }
+    if (inst.warmStartEnabled) {
+        output->print("Warm Boot: ");
+        output->println(inst.warmBoot ? "Yes" : "No");
+    }
+    if (inst.phyStarted) {
+        output->printf("PHY Power: %s (EEE %s, energy detect %s)\n",
+                       powerStateToString(inst.powerStats.state),
+                       inst.powerStats.eeeAdvertised ? "advertised" :
+                       inst.powerStats.eeeCapable ? "off" : "unsupported",
+                       inst.powerStats.energyDetect ? "on" : "off");
+    }
+    if (inst.wolEnabled) {
+        WakeOnLanStats wol = getWakeOnLanStats();
+        output->printf("Wake-on-LAN: %u suspends, %u magic wakes, %u spurious wakes, %u frames dropped\n",
+                       wol.suspends, wol.magicWakes, wol.spuriousWakes, wol.framesDropped);
+    }
+    if (inst.vlanActive()) {
+        output->printf("VLAN: %u tagged (rx %u, tx %u), %u virtual, %u dropped\n",
+                       inst.vlanId, inst.vlanStats.rxFrames, inst.vlanStats.txFrames,
+                       inst.vlanInterfaceCount, inst.stats.rxVlanDropped);
+        for (uint8_t i = 0; i < inst.vlanInterfaceCount; i++) {
+            const VlanStats& vs = inst.vlanInterfaces[i].stats;
+            output->printf("  VLAN %u: rx %u, tx %u, tx errors %u\n", vs.vid, vs.rxFrames, vs.txFrames, vs.txErrors);
+        }
+    }
+    if (inst.benchTask || inst.benchResult.durationMs) {
+        output->printf("Benchmark: %s %s, %.2f Mbit/s over %u ms, CPU %u%%/%u%%\n",
+                       benchmarkModeToString(inst.benchResult.mode),
+                       inst.benchTask ? "running" : inst.benchResult.completed ? "done" : "stopped",
+                       inst.benchResult.mbps, inst.benchResult.durationMs,
+                       inst.benchResult.cpuLoad[0], inst.benchResult.cpuLoad[1]);
+    }
+    if (inst.shaperEnabled) {
+        for (uint8_t i = 0; i < TRAFFIC_CLASSES; i++) {
+            TrafficClassStats ts = getTrafficClassStats((EthTrafficClass)i);
+            output->printf("Shaper %s: tx %u (delayed %u, dropped %u, avg delay %u us), rx %u (dropped %u)\n",
+                           trafficClassToString((EthTrafficClass)i), ts.txFrames, ts.txDelayed,
+                           ts.txDropped, ts.txDelayAvgUs, ts.rxFrames, ts.rxDropped);
+        }
+    }
+    if (inst.macFilterActive()) {
+        output->printf("MAC Filter: %u/%u addresses in hardware, multicast %s%s%s (%u overflows)\n",
+                       inst.macFilterStats.hardwareSlots, inst.macFilterStats.filters,
+                       inst.macFilterStats.multicastFiltered ? "filtered" : "passed",
+                       inst.broadcastDropEnabled ? ", broadcast dropped" : "",
+                       inst.promiscuousEnabled ? ", promiscuous" : "",
+                       inst.macFilterStats.overflows);
+    }
     output->print("Last Error: ");
     output->println(errorToString(inst.lastError));
 
     if (inst.phyStarted) {
         output->print("IP Address: ");
-        output->println(ETH.localIP().toString());
+        output->println(EthBackend::localIP().toString());
         output->print("MAC Address: ");
-        output->println(ETH.macAddress());
+        output->println(EthBackend::macAddress());
         output->print("Hostname: ");
-        output->println(ETH.getHostname());
+        output->println(EthBackend::hostname());
         output->print("Link Speed: ");
-        output->print(ETH.linkSpeed());
+        output->print(EthBackend::linkSpeed());
         output->println(" Mbps");
         output->print("Full Duplex: ");
-        output->println(ETH.fullDuplex() ? "Yes" : "No");
+        output->println(EthBackend::fullDuplex() ? "Yes" : "No");
+
+        if (inst.ipv6Enabled) {
+            for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES; i++) {
+                if (!inst.ip6Valid[i]) continue;
+                char buf[48];
+                snprintf(buf, sizeof(buf), IPV6STR, IPV62STR(inst.ip6Addrs[i]));
+                output->print("IPv6 Address: ");
+                output->println(buf);
+            }
+        }
     }
 
     NetworkStats currentStats = getStatistics();
@@ -941,6 +1146,59 @@ void EthernetManager::dumpDiagnostics(Print* output) {
     output->println(currentStats.reconnectCount);
     output->print("Link Down Events: ");
     output->println(currentStats.linkDownEvents);
+    FlapStats fs = getFlapStats();
+    output->print("Link Flaps: ");
+    output->print(fs.flapCount);
+    output->print(" (penalty ");
+    output->print(fs.currentPenalty);
+    output->print(", suppressed ");
+    output->print(fs.suppressCount);
+    output->print("x");
+    output->println(fs.suppressed ? ", HOLDING)" : ")");
+    BlipStats bs = getBlipStats();
+    output->print("Link Blips Held: ");
+    output->print(bs.holds);
+    output->print(" (resumed ");
+    output->print(bs.resumed);
+    output->print(", expired ");
+    output->print(bs.expired);
+    output->print(", max ");
+    output->print(bs.maxBlipMs);
+    output->println(" ms)");
+    output->print("TCP Aborts: ");
+    output->println(currentStats.tcpAborts);
+    output->print("Sleep Resumes: ");
+    output->println(currentStats.sleepResumes);
+    if (inst.rxClassifierEnabled) {
+        output->printf("RX Shed: %u broadcast, %u multicast, %u ARP, %u by EtherType\n",
+                       currentStats.rxShedBroadcast, currentStats.rxShedMulticast,
+                       currentStats.rxShedArp, currentStats.rxShedEtherType);
+    }
+    EventLoopStats es = getEventLoopStats();
+    output->print("Event Loop: ");
+    output->print(es.privateLoop ? "private" : "default");
+    if (es.privateLoop) {
+        output->print(" (forwarded ");
+        output->print(es.forwarded);
+        output->print(", dropped ");
+        output->print(es.dropped);
+        output->print(", dispatch avg/max ");
+        output->print(es.dispatchAvgUs);
+        output->print("/");
+        output->print(es.dispatchMaxUs);
+        output->print(" us)");
+    }
+    output->println();
+    output->print("DHCP Renewals: ");
+    output->print(currentStats.dhcpRenewals);
+    output->print(" (watchdog trips ");
+    output->print(currentStats.dhcpWatchdogTrips);
+    output->println(")");
+    output->print("DHCP Fallbacks: ");
+    output->print(currentStats.dhcpFallbacks);
+    output->print(" (address conflicts ");
+    output->print(currentStats.addressConflicts);
+    output->println(")");
 
     output->println("\n--- Configuration ---");
     output->print("Auto Reconnect: ");
@@ -953,6 +1211,67 @@ void EthernetManager::dumpDiagnostics(Print* output) {
         output->print("Current Delay: ");
         output->print(inst.reconnectCurrentDelay);
         output->println(" ms");
+        output->print("Last Recovery Action: ");
+        output->println(recoveryActionToString(inst.lastRecoveryAction));
+        output->print("Recoveries (DHCP/driver/PHY/netif): ");
+        output->print(currentStats.dhcpRestarts);
+        output->print("/");
+        output->print(currentStats.driverRestarts);
+        output->print("/");
+        output->print(currentStats.phyPowerCycles);
+        output->print("/");
+        output->println(currentStats.netifRecreates);
+    }
+
+    if (inst.failoverEnabled) {
+        FailoverStats fo = getFailoverStats();
+        output->println("\n--- WiFi Failover ---");
+        output->print("Active Uplink: ");
+        output->println(inst.activeUplink == EthUplink::ETHERNET ? "Ethernet" :
+                        inst.activeUplink == EthUplink::WIFI ? "WiFi" : "None");
+        output->print("Switchovers: ");
+        output->print(fo.switchoverCount);
+        output->print(" (failed ");
+        output->print(fo.failedSwitchovers);
+        output->println(")");
+        output->print("Failbacks: ");
+        output->println(fo.failbackCount);
+        output->print("Last/Max Switchover: ");
+        output->print(fo.lastSwitchoverUs);
+        output->print(" / ");
+        output->print(fo.maxSwitchoverUs);
+        output->println(" us");
+        output->print("Time on WiFi: ");
+        output->print(fo.wifiUplinkMs / 1000);
+        output->println(" seconds");
+    }
+
+    if (inst.healthEnabled) {
+        HealthStats hs = getHealthStats();
+        output->println("\n--- Health Monitor ---");
+        output->print("Health: ");
+        output->println(inst.health == EthHealth::HEALTHY ? "HEALTHY" :
+                        inst.health == EthHealth::DEGRADED ? "DEGRADED" : "UNKNOWN");
+        output->print("Gateway: ");
+        output->print(hs.gateway.recentLossPercent);
+        output->print("% loss, RTT avg ");
+        output->print(hs.gateway.rttAvgUs);
+        output->println(" us");
+        if (inst.healthTarget) {
+            output->print("Target: ");
+            output->print(hs.target.recentLossPercent);
+            output->print("% loss, RTT avg ");
+            output->print(hs.target.rttAvgUs);
+            output->println(" us");
+        }
+        output->print("Degraded Events: ");
+        output->print(hs.degradedEvents);
+        output->print(" (");
+        output->print(hs.degradedMs / 1000);
+        output->println(" seconds)");
+        output->print("Probe Interval: ");
+        output->print(hs.probeIntervalMs);
+        output->println(" ms");
     }
 
     output->println("=================================");
@@ -970,38 +1289,39 @@ void EthernetManager::updateStatistics() {
 
 void EthernetManager::attemptReconnect(TimerHandle_t xTimer) {
     auto& inst = getInstance();
-    ETH_LOG_I("Attempting to reconnect...");
+    EthRecoveryAction action = EthRecoveryAction::NONE;
 
     {
         MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
-        if (guard) {
-            inst.reconnectAttempts++;
+        if (!guard) {
+            xTimerStart(xTimer, 0);  // Try again next period
+            return;
+        }
 
-            // Check if we've exceeded max retries
-            if (inst.reconnectMaxRetries > 0 && inst.reconnectAttempts > inst.reconnectMaxRetries) {
-                ETH_LOG_E("Max reconnection attempts reached");
-                inst.autoReconnectEnabled = false;
-                return;
-            }
+        if (isConnected()) {
+            return;
         }
-    }
 
-    // Attempt to restart Ethernet
-    if (inst.phyStarted) {
-        // In ESP32 Arduino, we can't easily restart ETH
-        // So we'll just wait for the link to come back up
-        ETH_LOG_D("Waiting for link to restore...");
+        inst.reconnectAttempts++;
+
+        // Check if we've exceeded max retries
+        if (inst.reconnectMaxRetries > 0 && inst.reconnectAttempts > inst.reconnectMaxRetries) {
+            ETH_LOG_E("Max reconnection attempts reached");
+            inst.autoReconnectEnabled = false;
+            return;
+        }
+
+        action = inst.nextRecoveryAction();
     }
 
-    // Schedule next attempt with exponential backoff
+    ETH_LOG_I("Reconnect attempt %u: %s", inst.reconnectAttempts, recoveryActionToString(action));
+    inst.startRecovery(action);
+
+    // Schedule next attempt per the backoff policy
     {
         MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
         if (guard) {
-            inst.reconnectCurrentDelay = min(inst.reconnectCurrentDelay * 2, inst.reconnectMaxDelay);
-            if (inst.reconnectTimer) {
-                xTimerChangePeriod(inst.reconnectTimer, pdMS_TO_TICKS(inst.reconnectCurrentDelay), 0);
-                xTimerStart(inst.reconnectTimer, 0);
-            }
+            inst.scheduleReconnect();
         }
     }
 }
@@ -1025,85 +1345,249 @@ void EthernetManager::onEthEvent(void* arg, esp_event_base_t base, int32_t id, v
 
     ETH_LOG_D("Event: base='%s', id=%d at %lu ms", base, id, millis());
 
-    if (base == IP_EVENT && id == IP_EVENT_GOT_IP) {
-        ETH_LOG_I("IP_EVENT_GOT_IP received");
-        inst.gotIpAtLeastOnce = true;
-        inst.lastGotIpTime = millis();
+    if (base == IP_EVENT && (id == IP_EVENT_STA_GOT_IP || id == IP_EVENT_STA_LOST_IP)) {
+        // Standby WiFi uplink events are only of interest to failover
+        inst.handleFailoverIpEvent(id);
+        return;
+    }
 
-        // Update statistics
-        inst.stats.connectTime = millis();
-        if (inst.stats.disconnectCount > 0) {
-            inst.stats.reconnectCount++;
+    if (base == IP_EVENT && id == IP_EVENT_ETH_GOT_IP) {
+        auto* event = static_cast<ip_event_got_ip_t*>(data);
+        if (!event || !inst.isEthernetNetif(event->esp_netif)) {
+            return;  // Another Ethernet interface (e.g. an SPI MAC)
         }
-        inst.reconnectAttempts = 0;
-        inst.reconnectCurrentDelay = inst.reconnectInitialDelay;
+        ETH_LOG_I("IP_EVENT_ETH_GOT_IP received");
 
-        // Update state to connected
-        inst.changeState(EthConnectionState::CONNECTED);
+        // Static address already reported at link up
+        if (inst.consumeStaticGotIp(event->ip_info.ip.addr)) {
+            return;
+        }
 
-        xEventGroupSetBits(inst.ethEventGroup, BIT_CONNECTED);
-        logEthernetStatus();
+        // The held address coming back after a blip is not a new connection
+        if (inst.consumeHeldAddress(event->ip_info.ip.addr)) {
+            return;
+        }
 
-        // Call user callback if set
-        if (inst.connectedCallback) {
-            inst.connectedCallback(ETH.localIP());
+        // esp_netif reposts GOT_IP on every DHCP bind; an unchanged address
+        // while already holding one is a lease renewal
+        bool hadIpv4 = (xEventGroupGetBits(inst.ethEventGroup) & BIT_GOT_IP4) != 0;
+        if (hadIpv4 && !event->ip_changed && inst.addressSource == EthAddressSource::DHCP) {
+            inst.stats.dhcpRenewals++;
+            ETH_LOG_D("DHCP lease renewed");
+            // Refresh the cached obtain time so the record does not age out
+            inst.persistLease();
+            return;
         }
+        xEventGroupSetBits(inst.ethEventGroup, BIT_GOT_IP4);
+
+        // Link-to-IP timing and lease persistence
+        inst.handleDhcpLease(event->ip_info.ip.addr);
+
+        // Announce the address and resolve the gateway before the app needs it
+        inst.heldLease.ip = event->ip_info.ip.addr;
+        inst.heldLease.netmask = event->ip_info.netmask.addr;
+        inst.heldLease.gateway = event->ip_info.gw.addr;
+        inst.startArpPrewarm(event->ip_info.ip.addr, event->ip_info.netmask.addr,
+                             event->ip_info.gw.addr);
+
+        // Every IPv4 (re)assignment is announced, as before IPv6 tracking
+        inst.evaluateReadiness(true);
+        return;
+    }
 
+    if (base == IP_EVENT && id == IP_EVENT_ETH_LOST_IP) {
+        auto* event = static_cast<ip_event_got_ip_t*>(data);
+        if (event && inst.isEthernetNetif(event->esp_netif)) {
+            inst.handleLostIp();
+        }
+        return;
+    }
+
+    if (base == IP_EVENT && id == IP_EVENT_GOT_IP6) {
+        auto* event = static_cast<ip_event_got_ip6_t*>(data);
+        if (!event || !inst.isEthernetNetif(event->esp_netif)) {
+            return;
+        }
+
+        int index = event->ip_index;
+        if (index < 0 || index >= ETH_MAX_IPV6_ADDRESSES) {
+            ETH_LOG_W("IPv6 address index %d out of range", index);
+            return;
+        }
+
+        inst.ip6Addrs[index] = event->ip6_info.ip;
+        inst.ip6Valid[index] = true;
+        inst.stats.ipv6AddrEvents++;
+
+        esp_ip6_addr_type_t type = esp_netif_ip6_get_addr_type(&event->ip6_info.ip);
+        ETH_LOG_I("IPv6 address [%d]: " IPV6STR " (%s)", index, IPV62STR(event->ip6_info.ip),
+                  type == ESP_IP6_ADDR_IS_LINK_LOCAL ? "link-local" :
+                  type == ESP_IP6_ADDR_IS_UNIQUE_LOCAL ? "unique-local" :
+                  type == ESP_IP6_ADDR_IS_GLOBAL ? "global" : "other");
+
+        if (hasRoutableIPv6()) {
+            xEventGroupSetBits(inst.ethEventGroup, BIT_GOT_IP6);
+        }
+        inst.evaluateReadiness(false);
         return;
     }
 
     if (base == ETH_EVENT) {
+        // Only our driver's events; an SPI MAC on the same loop posts its own
+        // handle. Without a backend handle (Arduino 2.x) the EMAC is the only one.
+        esp_eth_handle_t handle = data ? *static_cast<esp_eth_handle_t*>(data) : nullptr;
+        esp_eth_handle_t own = EthBackend::handle();
+        if (!handle || (own && handle != own)) {
+            return;
+        }
+        // Driver handle for stop/start and PHY register access
+        inst.ethHandle = handle;
+
         switch (id) {
             case ETHERNET_EVENT_START:
                 ETH_LOG_D("ETH Started at %lu ms", millis());
                 // Don't set hostname here - already done in begin()
+                // PHY power-saving bits do not survive a PHY reset or power cycle
+                inst.applyPhyPowerPolicy();
+                // Driver install resets the EMAC filter and the receive path
+                if (inst.receiveHookNeeded()) {
+                    inst.restoreReceivePath();
+                }
+                if (inst.egressHookNeeded()) {
+                    inst.attachEgressHook();
+                }
                 break;
 
             case ETHERNET_EVENT_CONNECTED:
                 ETH_LOG_D("ETH Connected at %lu ms", millis());
+                if (inst.bootToLinkMs == 0) {
+                    inst.bootToLinkMs = (uint32_t)(esp_timer_get_time() / 1000);
+                }
+
+                // netif_add() on driver start clears the lwIP filter hooks
+                if (inst.macFilterActive()) {
+                    inst.restoreReceivePath();
+                }
+                // Again here in case the netif was added after our START handler ran
+                if (inst.egressHookNeeded()) {
+                    inst.attachEgressHook();
+                }
+
+                // Suspended: the link is re-read on resume
+                if (inst.wolArmed) {
+                    break;
+                }
+
+                // Back within the hold grace period: restore, don't rediscover
+                if (inst.connectionState == EthConnectionState::LINK_DOWN_HOLDING) {
+                    inst.restoreLinkHold();
+                    if (inst.ipv6Enabled && inst.eth_netif) {
+                        esp_netif_create_ip6_linklocal(inst.eth_netif);
+                    }
+                    break;
+                }
+
                 inst.connectionStartTime = millis();
-                // Update state to obtaining IP (link is up but no IP yet)
-                inst.changeState(EthConnectionState::OBTAINING_IP);
-                inst.updateLinkStatus();
+
+                // Note whether lwIP will INIT-REBOOT, and restore a trusted sleep lease
+                inst.startLeaseSeed();
+
+                // Bound the time spent waiting for DHCP
+                inst.armDhcpFallback();
+
+                // Link-local address starts SLAAC; GOT_IP6 reports each address
+                if (inst.ipv6Enabled && inst.eth_netif) {
+                    esp_err_t err = esp_netif_create_ip6_linklocal(inst.eth_netif);
+                    if (err != ESP_OK) {
+                        ETH_LOG_W("Failed to create IPv6 link-local address: %d", err);
+                    }
+                }
+
+                // Update state to obtaining IP (link is up but no IP yet);
+                // a damped link stays reported down until the penalty decays
+                if (!inst.linkSuppressed) {
+                    inst.changeState(EthConnectionState::OBTAINING_IP);
+                    inst.updateLinkStatus();
+                    inst.applyStaticFastPath();
+                }
                 break;
 
             case ETHERNET_EVENT_DISCONNECTED:
             case ETHERNET_EVENT_STOP: {
                 unsigned long now = millis();
 
-                if (!inst.gotIpAtLeastOnce) {
-                    ETH_LOG_W("Ignoring disconnect: no IP was ever assigned");
+                // Suspended: the filter stays armed and the link is re-read on resume
+                if (inst.wolArmed) {
                     break;
                 }
 
-                if (now - inst.connectionStartTime < ETH_CONNECTION_TRUST_WINDOW_MS) {
-                    ETH_LOG_W("Ignoring disconnect within trust window (%lu ms)",
-                                 now - inst.connectionStartTime);
+                // Application power-down: report it now, no hold, damping or trust window
+                if (inst.phyLowPower) {
+                    if (inst.holdGraceTimer) {
+                        xTimerStop(inst.holdGraceTimer, 0);
+                    }
+                    if (inst.gotIpAtLeastOnce) {
+                        inst.confirmDisconnect();
+                    } else {
+                        inst.changeState(EthConnectionState::LINK_DOWN);
+                    }
                     break;
                 }
 
-                ETH_LOG_E("ETH Disconnected after stable window");
-                inst.gotIpAtLeastOnce = false;
-                xEventGroupClearBits(inst.ethEventGroup, BIT_CONNECTED);
+                // Every carrier loss counts towards the flap penalty
+                if (id == ETHERNET_EVENT_DISCONNECTED) {
+                    bool wasSuppressed = inst.linkSuppressed;
+                    inst.recordFlap();
+
+                    // Damping just kicked in: the link is reported down until it
+                    // settles, regardless of trust window or hold grace
+                    if (!wasSuppressed && inst.linkSuppressed) {
+                        if (inst.holdGraceTimer) {
+                            xTimerStop(inst.holdGraceTimer, 0);
+                        }
+                        inst.holdRestorePending = false;
+                        if (inst.gotIpAtLeastOnce) {
+                            inst.stats.linkDownEvents++;
+                            inst.confirmDisconnect();
+                        } else {
+                            inst.changeState(EthConnectionState::LINK_DOWN);
+                        }
+                        break;
+                    }
+                }
 
-                // Update state to link down
-                inst.changeState(EthConnectionState::LINK_DOWN);
+                if (inst.connectionState == EthConnectionState::LINK_DOWN_HOLDING) {
+                    inst.holdRestorePending = false;
+                    if (id == ETHERNET_EVENT_DISCONNECTED) {
+                        break;  // Bounced again inside the grace period
+                    }
+                    // Driver stopped: no point waiting for the carrier
+                    if (inst.holdGraceTimer) {
+                        xTimerStop(inst.holdGraceTimer, 0);
+                    }
+                    inst.confirmDisconnect();
+                    break;
+                }
 
-                // Update statistics
-                inst.stats.disconnectCount++;
-                inst.stats.linkDownEvents++;
-                uint32_t connectionDuration = millis() - inst.stats.connectTime;
+                if (!inst.gotIpAtLeastOnce) {
+                    ETH_LOG_W("Ignoring disconnect: no IP was ever assigned");
+                    break;
+                }
 
-                // Call user callback if set
-                if (inst.disconnectedCallback) {
-                    inst.disconnectedCallback(connectionDuration);
+                if (now - inst.connectionStartTime < ETH_CONNECTION_TRUST_WINDOW_MS) {
+                    ETH_LOG_W("Ignoring disconnect within trust window (%lu ms)",
+                                 now - inst.connectionStartTime);
+                    break;
                 }
 
-                // Start auto-reconnect if enabled
-                if (inst.autoReconnectEnabled && inst.reconnectTimer) {
-                    xTimerStart(inst.reconnectTimer, 0);
+                // Short blips keep the address until the grace period runs out
+                if (id == ETHERNET_EVENT_DISCONNECTED && inst.beginLinkHold()) {
+                    break;
                 }
 
+                ETH_LOG_E("ETH Disconnected after stable window");
+                inst.stats.linkDownEvents++;
+                inst.confirmDisconnect();
                 break;
             }
 
@@ -1111,9 +1595,203 @@ void EthernetManager::onEthEvent(void* arg, esp_event_base_t base, int32_t id, v
                 ETH_LOG_W("Unhandled ETH event ID: %d", id);
                 break;
         }
+
+        // PHY time-in-state accounting
+        inst.accountPowerState(id == ETHERNET_EVENT_CONNECTED);
+
+        // Virtual VLAN interfaces follow the physical link
+        if (inst.vlanActive()) {
+            inst.forwardVlanEvent(id);
+        }
+    }
+}
+
+bool EthernetManager::readinessSatisfied() const {
+    EventBits_t bits = xEventGroupGetBits(ethEventGroup);
+    bool v4 = (bits & BIT_GOT_IP4) != 0;
+    bool v6 = (bits & BIT_GOT_IP6) != 0;
+
+    switch (readyPolicy) {
+        case EthIpReadyPolicy::IPV6: return v6;
+        case EthIpReadyPolicy::EITHER: return v4 || v6;
+        case EthIpReadyPolicy::BOTH: return v4 && v6;
+        case EthIpReadyPolicy::IPV4:
+        default: return v4;
     }
 }
 
+void EthernetManager::evaluateReadiness(bool reannounce) {
+    if (linkSuppressed || wolArmed || !readinessSatisfied()) return;
+    if (connectionState == EthConnectionState::LINK_DOWN_HOLDING) return;
+    if (isConnected() && !reannounce) return;
+
+    gotIpAtLeastOnce = true;
+    lastGotIpTime = millis();
+
+    // Update statistics
+    stats.connectTime = millis();
+    if (stats.disconnectCount > 0) {
+        stats.reconnectCount++;
+    }
+    reconnectAttempts = 0;
+    reconnectCurrentDelay = reconnectInitialDelay;
+
+    // Update state to connected
+    changeState(EthConnectionState::CONNECTED);
+
+    xEventGroupSetBits(ethEventGroup, BIT_CONNECTED);
+    logEthernetStatus();
+
+    // Call user callback if set (0.0.0.0 when ready on IPv6 only)
+    if (connectedCallback) {
+        connectedCallback(EthBackend::localIP());
+    }
+}
+
+EthBackendConfig EthernetManager::backendConfig() const {
+    EthBackendConfig cfg = {};
+    cfg.hostname = beginHostname[0] ? beginHostname : nullptr;
+    cfg.phyAddr = beginPhyAddr;
+    cfg.mdcPin = beginMdcPin;
+    cfg.mdioPin = beginMdioPin;
+    cfg.powerPin = beginPowerPin;
+    cfg.clockMode = beginClockMode;
+    cfg.mac = hasCustomMac ? customMacAddress : nullptr;
+    cfg.keepPhyState = keepPhyState;
+    cfg.staticIp = staticIpMode;
+    cfg.ip = staticIp;
+    cfg.gateway = staticGateway;
+    cfg.subnet = staticSubnet;
+    cfg.dns1 = staticDns1;
+    cfg.dns2 = staticDns2;
+    return cfg;
+}
+
+bool EthernetManager::isEthernetNetif(esp_netif_t* netif) {
+    if (!netif) return false;
+    if (!eth_netif) {
+        // Events can beat internalInit() storing the handle
+        eth_netif = EthBackend::netif();
+    }
+    return netif == eth_netif;
+}
+
+void EthernetManager::handleLostIp() {
+    // Address loss during a held blip or after link down is already handled;
+    // while suspended the address is re-evaluated on resume
+    if (connectionState == EthConnectionState::LINK_DOWN_HOLDING || wolArmed ||
+        (xEventGroupGetBits(ethEventGroup) & BIT_GOT_IP4) == 0) {
+        return;
+    }
+
+    ETH_LOG_W("IPv4 address lost with link up");
+    xEventGroupClearBits(ethEventGroup, BIT_GOT_IP4);
+    addressSource = EthAddressSource::NONE;
+    if (arpPrewarmTimer) {
+        xTimerStop(arpPrewarmTimer, 0);
+    }
+
+    // Still ready per policy (IPv6): nothing else changes
+    if (readinessSatisfied()) return;
+
+    bool wasConnected = connectionState == EthConnectionState::CONNECTED;
+    xEventGroupClearBits(ethEventGroup, BIT_CONNECTED);
+
+    // Link is still up: wait for DHCP again (watchdog applies)
+    changeState(EthConnectionState::OBTAINING_IP);
+
+    if (wasConnected) {
+        stats.disconnectCount++;
+        if (disconnectedCallback) {
+            disconnectedCallback(millis() - stats.connectTime);
+        }
+    }
+}
+
+void EthernetManager::confirmDisconnect() {
+    gotIpAtLeastOnce = false;
+    holdConfirmPending = false;
+    staticFastPathPending = false;
+    clearAddresses();
+
+    // Update state to link down
+    changeState(EthConnectionState::LINK_DOWN);
+
+    // Update statistics
+    stats.disconnectCount++;
+    uint32_t connectionDuration = millis() - stats.connectTime;
+
+    // Fail stale connections now instead of after TCP retransmission timeouts
+    uint32_t aborted = socketAbortEnabled ? abortConnections() : 0;
+    if (socketAbortCallback) {
+        socketAbortCallback(aborted);
+    }
+
+    // Call user callback if set
+    if (disconnectedCallback) {
+        disconnectedCallback(connectionDuration);
+    }
+
+    // Start auto-reconnect if enabled (not while the PHY is powered down on purpose)
+    if (autoReconnectEnabled && reconnectTimer && !phyLowPower) {
+        scheduleReconnect();
+    }
+}
+
+void EthernetManager::clearAddresses() {
+    if (ethEventGroup) {
+        xEventGroupClearBits(ethEventGroup, BIT_READY_MASK);
+    }
+    addressSource = EthAddressSource::NONE;
+    if (arpPrewarmTimer) {
+        xTimerStop(arpPrewarmTimer, 0);
+    }
+    memset(ip6Valid, 0, sizeof(ip6Valid));
+}
+
+void EthernetManager::setIPv6(bool enable, EthIpReadyPolicy policy) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.ipv6Enabled = enable;
+        inst.readyPolicy = enable ? policy : EthIpReadyPolicy::IPV4;
+
+        // Link already up: create the link-local address now
+        if (enable && inst.eth_netif && inst.phyStarted && EthBackend::linkUp()) {
+            esp_netif_create_ip6_linklocal(inst.eth_netif);
+        }
+        ETH_LOG_I("IPv6 %s", enable ? "enabled" : "disabled");
+    }
+}
+
+uint8_t EthernetManager::getIPv6Addresses(esp_ip6_addr_t* addrs, uint8_t maxAddrs) {
+    auto& inst = getInstance();
+    if (!addrs || maxAddrs == 0) return 0;
+
+    uint8_t count = 0;
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES && count < maxAddrs; i++) {
+            if (inst.ip6Valid[i]) {
+                addrs[count++] = inst.ip6Addrs[i];
+            }
+        }
+    }
+    return count;
+}
+
+bool EthernetManager::hasRoutableIPv6() {
+    auto& inst = getInstance();
+    for (uint8_t i = 0; i < ETH_MAX_IPV6_ADDRESSES; i++) {
+        if (!inst.ip6Valid[i]) continue;
+        esp_ip6_addr_type_t type = esp_netif_ip6_get_addr_type(&inst.ip6Addrs[i]);
+        if (type == ESP_IP6_ADDR_IS_GLOBAL || type == ESP_IP6_ADDR_IS_UNIQUE_LOCAL) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void EthernetManager::setLinkMonitoring(bool enable, uint32_t intervalMs) {
     auto& inst = getInstance();
     MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
@@ -1148,7 +1826,7 @@ bool EthernetManager::checkLinkStatus() {
     if (!inst.phyStarted) return false;
 
     // Get current link status from ETH
-    bool linkUp = ETH.linkUp();
+    bool linkUp = EthBackend::linkUp();
 
     // Update our tracking
     inst.updateLinkStatus();
@@ -1208,6 +1886,15 @@ void EthernetManager::changeState(EthConnectionState newState) {
     if (stateChangeCallback) {
         stateChangeCallback(previousState, newState);
     }
+
+    // Move the default route between Ethernet and the standby uplink
+    handleFailoverStateChange(newState);
+
+    // Re-probe reachability on every (re)connect
+    handleHealthStateChange(newState);
+
+    // Bound the time spent in OBTAINING_IP
+    handleDhcpWatchdogStateChange(newState);
     
     // Track timing for performance monitoring
     switch (newState) {
@@ -1220,6 +1907,9 @@ void EthernetManager::changeState(EthConnectionState newState) {
             break;
         case EthConnectionState::CONNECTED:
             ipObtainedTime = millis();
+            if (bootToIpMs == 0) {
+                bootToIpMs = (uint32_t)(esp_timer_get_time() / 1000);
+            }
             ETH_LOG_D("IP obtained after %lu ms (link up: %lu ms)", 
                          ipObtainedTime - initStartTime, linkUpTime - initStartTime);
             break;
@@ -1231,7 +1921,14 @@ void EthernetManager::changeState(EthConnectionState newState) {
 bool EthernetManager::updateLinkStatus() {
     if (!phyStarted) return false;
     
-    bool currentLinkStatus = ETH.linkUp();
+    bool currentLinkStatus = EthBackend::linkUp();
+
+    // Edges are reported once flap damping releases the link; a held blip
+    // is only reported if it outlasts the grace period; a suspended manager
+    // reports the link when it resumes
+    if (linkSuppressed || wolArmed || connectionState == EthConnectionState::LINK_DOWN_HOLDING) {
+        return currentLinkStatus;
+    }
     
     if (currentLinkStatus != lastLinkStatus) {
         lastLinkStatus = currentLinkStatus;
@@ -1275,21 +1972,22 @@ bool EthernetManager::resetInterface() {
     }
 
     // Clear connected state
-    xEventGroupClearBits(inst.ethEventGroup, BIT_CONNECTED);
+    inst.clearAddresses();
     inst.gotIpAtLeastOnce = false;
 
     // Update state
     inst.changeState(EthConnectionState::LINK_DOWN);
 
-    // Note: ESP32 Arduino doesn't provide a way to reset ETH without full restart
-    // This is a limitation of the framework
-    ETH_LOG_W("Full interface reset not available in Arduino framework");
+    // Restart the driver now; auto-reconnect escalates from there if needed
+    inst.stats.driverRestarts++;
+    if (!inst.ethHandle || esp_eth_stop(inst.ethHandle) != ESP_OK || esp_eth_start(inst.ethHandle) != ESP_OK) {
+        ETH_LOG_W("Driver restart failed");
+    }
 
-    // We can at least try to trigger reconnection
     if (inst.autoReconnectEnabled && inst.reconnectTimer) {
-        inst.reconnectAttempts = 0;
-        inst.reconnectCurrentDelay = inst.reconnectInitialDelay;
-        xTimerStart(inst.reconnectTimer, 0);
+        inst.reconnectAttempts = ETH_RECOVERY_ATTEMPTS_PER_STEP;  // Continue the ladder at the driver step
+        inst.reconnectCurrentDelay = 0;
+        inst.scheduleReconnect();
     }
 
     return true;
@@ -1364,9 +2062,9 @@ bool EthernetManager::getQuickStatus(IPAddress& ip, int& linkSpeed, bool& fullDu
         return false;
     }
     
-    ip = ETH.localIP();
-    linkSpeed = ETH.linkSpeed();
-    fullDuplex = ETH.fullDuplex();
+    ip = EthBackend::localIP();
+    linkSpeed = EthBackend::linkSpeed();
+    fullDuplex = EthBackend::fullDuplex();
     
     return true;
 }
@@ -1433,6 +2131,45 @@ bool EthernetManager::getPerformanceMetrics(uint32_t& initTimeMs, uint32_t& link
     return true;
 }
 
+bool EthernetManager::getPerformanceMetrics(PerformanceMetrics& metrics) {
+    auto& inst = getInstance();
+    memset(&metrics, 0, sizeof(metrics));
+    if (!getPerformanceMetrics(metrics.initTimeMs, metrics.linkUpTimeMs,
+                               metrics.ipObtainTimeMs, metrics.eventCount)) {
+        return false;
+    }
+
+    metrics.lastLinkToIpMs = inst.lastLinkToIpMs;
+    metrics.linkToIpCachedCount = inst.linkToIpCachedCount;
+    metrics.linkToIpCachedAvgMs = inst.linkToIpCachedCount > 0 ?
+        inst.linkToIpCachedTotalMs / inst.linkToIpCachedCount : 0;
+    metrics.linkToIpUncachedCount = inst.linkToIpUncachedCount;
+    metrics.linkToIpUncachedAvgMs = inst.linkToIpUncachedCount > 0 ?
+        inst.linkToIpUncachedTotalMs / inst.linkToIpUncachedCount : 0;
+    metrics.leaseCacheMisses = inst.leaseCacheMisses;
+    metrics.arpResolveLastUs = inst.arpResolveLastUs;
+    metrics.arpResolveMaxUs = inst.arpResolveMaxUs;
+    metrics.arpResolveCount = inst.arpResolveCount;
+    metrics.arpResolveAvgUs = inst.arpResolveCount > 0 ?
+        (uint32_t)(inst.arpResolveTotalUs / inst.arpResolveCount) : 0;
+    metrics.arpResolveFailures = inst.arpResolveFailures;
+    metrics.gratuitousArpsSent = inst.gratuitousArpsSent;
+    metrics.bootToIpMs = inst.bootToIpMs;
+    metrics.bootToLinkMs = inst.bootToLinkMs;
+    metrics.warmStart = inst.warmBoot;
+    metrics.warmStartSavedMs = inst.warmBoot && inst.bootToLinkMs > 0 && inst.warmBaselineMs > inst.bootToLinkMs ?
+        inst.warmBaselineMs - inst.bootToLinkMs : 0;
+    metrics.sleepResumed = inst.sleepResumed;
+    metrics.wakeToIpMs = esp_reset_reason() == ESP_RST_DEEPSLEEP ? inst.bootToIpMs : 0;
+    metrics.wakeToIpBaselineMs = inst.sleepResumed ? inst.sleepBaselineMs : 0;
+    metrics.staticFastPathCount = inst.staticFastPathCount;
+    metrics.staticFastPathSavedUs = inst.staticFastPathSavedUs;
+    metrics.staticFastPathAvgUs = inst.staticFastPathCount > 0 ?
+        (uint32_t)(inst.staticFastPathSavedTotalUs / inst.staticFastPathCount) : 0;
+
+    return true;
+}
+
 void EthernetManager::processBatchedEvents(TimerHandle_t xTimer) {
     auto& inst = getInstance();
     if (!inst.eventQueue) return;
@@ -2,9 +2,10 @@
 #pragma once
 
 #include <Arduino.h>
-#include <ETH.h>
+#include "EthernetManagerBackend.h"
 #include <freertos/event_groups.h>
 #include <freertos/semphr.h>
+#include <esp_event.h>
 #include <esp_netif.h>
 #include <functional>
 
@@ -54,6 +55,54 @@ struct NetworkStats {
     uint32_t dhcpRenewals;       ///< DHCP renewal count
     uint32_t lastErrorCode;      ///< Last error code
     uint32_t uptimeMs;           ///< Connection uptime in ms
+    uint32_t ipv6Addresses;      ///< IPv6 addresses currently assigned
+    uint32_t ipv6AddrEvents;     ///< IPv6 address (SLAAC/DHCPv6/link-local) events
+    uint32_t dhcpFallbacks;      ///< DHCP timeouts that fell back to static/AutoIP
+    uint32_t addressConflicts;   ///< ARP probes that found the address in use
+    uint32_t dhcpRestarts;       ///< Recovery: DHCP client restarts
+    uint32_t driverRestarts;     ///< Recovery: esp_eth_stop/start cycles
+    uint32_t phyPowerCycles;     ///< Recovery: PHY resets via the power pin
+    uint32_t netifRecreates;     ///< Recovery: full driver + netif recreations
+    uint32_t dhcpWatchdogTrips;  ///< OBTAINING_IP watchdog expiries
+    uint32_t tcpAborts;          ///< TCP connections aborted on confirmed disconnect
+    uint32_t sleepResumes;       ///< Deep-sleep wakes resumed from the RTC snapshot
+    uint32_t rxShedBroadcast;    ///< Broadcast frames dropped by the receive classifier
+    uint32_t rxShedMulticast;    ///< Multicast frames dropped by the receive classifier
+    uint32_t rxShedArp;          ///< ARP requests for other hosts dropped by the classifier
+    uint32_t rxShedEtherType;    ///< Frames dropped by EtherType classifier rules
+    uint32_t rxVlanDropped;      ///< Frames for a VLAN we are not on, or untagged on a tagged port
+};
+
+/**
+ * @brief Extended performance metrics
+ */
+struct PerformanceMetrics {
+    uint32_t initTimeMs;             ///< PHY start to link up (ms)
+    uint32_t linkUpTimeMs;           ///< Link up to IP (ms)
+    uint32_t ipObtainTimeMs;         ///< PHY start to IP (ms)
+    uint32_t eventCount;             ///< Total events processed
+    uint32_t lastLinkToIpMs;         ///< Last link up to IPv4 address (ms)
+    uint32_t linkToIpCachedAvgMs;    ///< Average link-to-IP using the cached lease (INIT-REBOOT)
+    uint32_t linkToIpCachedCount;    ///< Samples behind linkToIpCachedAvgMs
+    uint32_t linkToIpUncachedAvgMs;  ///< Average link-to-IP via full DISCOVER
+    uint32_t linkToIpUncachedCount;  ///< Samples behind linkToIpUncachedAvgMs
+    uint32_t leaseCacheMisses;       ///< Cached lease requested but a different address was bound
+    uint32_t arpResolveLastUs;       ///< Last gateway/peer ARP resolution after GOT_IP (us)
+    uint32_t arpResolveAvgUs;        ///< Average ARP resolution time (us)
+    uint32_t arpResolveMaxUs;        ///< Slowest ARP resolution (us)
+    uint32_t arpResolveCount;        ///< Samples behind arpResolveAvgUs
+    uint32_t arpResolveFailures;     ///< Targets unresolved after ETH_ARP_PREWARM_TIMEOUT_MS
+    uint32_t gratuitousArpsSent;     ///< Gratuitous ARP announcements sent
+    uint32_t bootToIpMs;             ///< Chip boot to first CONNECTED (ms, 0 until then)
+    uint32_t staticFastPathCount;    ///< Static-IP link ups reported CONNECTED ahead of GOT_IP
+    uint32_t staticFastPathSavedUs;  ///< Last fast-path lead over the GOT_IP event (us)
+    uint32_t staticFastPathAvgUs;    ///< Average lead over GOT_IP (us)
+    uint32_t bootToLinkMs;           ///< Chip boot to first link up (ms, 0 until then)
+    bool warmStart;                  ///< This boot kept the PHY's negotiated link
+    uint32_t warmStartSavedMs;       ///< Boot-to-link gain over the last cold boot (ms)
+    bool sleepResumed;               ///< This wake restored the deep-sleep snapshot
+    uint32_t wakeToIpMs;             ///< Deep-sleep wake to first CONNECTED (ms, 0 if not a wake)
+    uint32_t wakeToIpBaselineMs;     ///< Same measurement from the last start without a snapshot (ms)
 };
 
 /**
@@ -67,7 +116,308 @@ enum class EthConnectionState {
     OBTAINING_IP,      ///< DHCP in progress
     CONNECTED,         ///< Fully connected with IP
     DISCONNECTING,     ///< Disconnection in progress
-    ERROR_STATE        ///< Error state
+    ERROR_STATE,       ///< Error state
+    LINK_DOWN_HOLDING, ///< Link lost within the grace period; address retained
+    SUSPENDED          ///< Wake-on-LAN: lwIP input cut, waiting for a magic packet
+};
+
+/**
+ * @brief Which address families must be assigned before CONNECTED is reported
+ */
+enum class EthIpReadyPolicy {
+    IPV4,              ///< IPv4 address required (default)
+    IPV6,              ///< Routable IPv6 address required
+    EITHER,            ///< IPv4 or routable IPv6 address
+    BOTH               ///< IPv4 and routable IPv6 address
+};
+
+/**
+ * @brief Where the current IPv4 address came from
+ */
+enum class EthAddressSource {
+    NONE,              ///< No IPv4 address
+    DHCP,              ///< Leased from a DHCP server
+    STATIC,            ///< Configured static address (initializeStatic)
+    FALLBACK_STATIC,   ///< Configured fallback after DHCP timeout
+    AUTOIP             ///< Self-assigned 169.254/16 link-local address
+};
+
+/**
+ * @brief Uplink currently carrying the default route
+ */
+enum class EthUplink {
+    NONE,              ///< No usable uplink
+    ETHERNET,          ///< Default route on the Ethernet netif
+    WIFI               ///< Default route on the standby WiFi STA netif
+};
+
+/**
+ * @brief How the standby WiFi STA is kept while Ethernet is healthy
+ */
+enum class EthFailoverMode {
+    PRE_ASSOCIATED,    ///< Stay associated with an IP; switchover is a route change
+    FAST_CONNECT       ///< Stay idle with cached BSSID/channel; associate on link loss
+};
+
+/**
+ * @brief Delay policy between reconnect attempts
+ */
+enum class EthBackoffPolicy {
+    EXPONENTIAL,          ///< initial * 2^n, capped (no jitter, default)
+    FULL_JITTER,          ///< Uniform in [0, exponential delay]
+    DECORRELATED_JITTER,  ///< Uniform in [initial, 3 * previous], capped
+    CUSTOM                ///< User EthBackoffFunction
+};
+
+/**
+ * @brief Recovery step taken by a reconnect attempt, in escalation order
+ */
+enum class EthRecoveryAction {
+    NONE,                 ///< Nothing to do (already connected)
+    DHCP_RESTART,         ///< esp_netif_dhcpc_stop/start
+    DRIVER_RESTART,       ///< esp_eth_stop/start
+    PHY_POWER_CYCLE,      ///< Driver stop, PHY power pin low/high, driver start
+    NETIF_RECREATE        ///< Tear down and recreate driver and netif
+};
+
+/**
+ * @brief Layer-3 reachability as seen by the health monitor
+ */
+enum class EthHealth {
+    UNKNOWN,           ///< Not connected or not probed yet
+    HEALTHY,           ///< Gateway (and target) answering
+    DEGRADED           ///< Link and IP up but probes failing
+};
+
+/**
+ * @brief Frame class matched by a receive classifier rule
+ */
+enum class EthRxMatch {
+    BROADCAST,         ///< Destination ff:ff:ff:ff:ff:ff
+    MULTICAST,         ///< Group destination other than broadcast
+    ARP_FOREIGN,       ///< ARP request for an address other than ours
+    ETHERTYPE          ///< Outer EtherType equal to the rule's value
+};
+
+/**
+ * @brief Traffic shaper class, highest priority first
+ */
+enum class EthTrafficClass {
+    CONTROL,           ///< Served first; ARP and DSCP CS6/CS7 by default
+    HIGH,
+    NORMAL,            ///< Default for unmatched traffic
+    BULK
+};
+
+/**
+ * @brief Frame field a traffic shaper rule matches on
+ */
+enum class EthTrafficMatch {
+    DSCP,              ///< IPv4/IPv6 DSCP value
+    PORT,              ///< TCP or UDP source or destination port
+    ETHERTYPE          ///< Outer EtherType
+};
+
+/**
+ * @brief Per-class traffic shaper statistics
+ */
+struct TrafficClassStats {
+    uint32_t txFrames;             ///< Frames handed to the driver
+    uint32_t txBytes;              ///< Bytes handed to the driver
+    uint32_t txDelayed;            ///< Frames that waited in the queue for tokens
+    uint32_t txDropped;            ///< Frames refused with the queue full
+    uint32_t txDelayAvgUs;         ///< Average queueing delay of delayed frames (us)
+    uint32_t txDelayMaxUs;         ///< Longest queueing delay (us)
+    uint32_t rxFrames;             ///< Received frames classified into this class
+    uint32_t rxDropped;            ///< Received frames over the ingress limit
+    uint8_t queued;                ///< Frames waiting now
+};
+
+/**
+ * @brief Per-VLAN frame counters
+ */
+struct VlanStats {
+    uint16_t vid;                  ///< VLAN id (0 if not configured)
+    uint32_t rxFrames;             ///< Frames received with this tag
+    uint32_t rxBytes;              ///< Bytes received, tag excluded
+    uint32_t txFrames;             ///< Frames sent with this tag
+    uint32_t txBytes;              ///< Bytes sent, tag excluded
+    uint32_t txErrors;             ///< Frames the driver refused or too large to tag
+};
+
+/**
+ * @brief Throughput benchmark role and transport
+ */
+enum class EthBenchmarkMode {
+    TCP_CLIENT,        ///< Connect and send for the configured duration
+    TCP_SERVER,        ///< Accept one connection and receive until it closes
+    UDP_CLIENT,        ///< Send sequenced datagrams at a fixed rate
+    UDP_SERVER         ///< Receive datagrams; measures loss and jitter
+};
+
+/**
+ * @brief Result of the current or last throughput benchmark
+ */
+struct BenchmarkResult {
+    EthBenchmarkMode mode;         ///< Role and transport of the run
+    bool running;                  ///< Benchmark task active
+    bool completed;                ///< Run finished normally (not stopped or failed)
+    EthError error;                ///< Reason for a failed run
+    uint32_t durationMs;           ///< Measured time, first to last byte
+    uint64_t bytes;                ///< Payload bytes sent or received
+    float mbps;                    ///< Payload throughput (Mbit/s)
+    uint32_t datagrams;            ///< UDP datagrams sent or received
+    uint32_t lost;                 ///< UDP server: datagrams missing from the sequence
+    uint32_t outOfOrder;           ///< UDP server: datagrams that arrived late
+    float lossPercent;             ///< UDP server: lost / expected
+    float jitterMs;                ///< UDP server: RFC 3550 interarrival jitter (ms)
+    uint8_t cpuLoad[2];            ///< Busy percent per core over the run (255 if unavailable)
+};
+
+/**
+ * @brief Probe statistics for one health monitor destination
+ */
+struct HealthProbeStats {
+    uint32_t sent;                 ///< Echo requests sent
+    uint32_t lost;                 ///< Requests without a reply in time
+    uint8_t recentLossPercent;     ///< Loss over the last ETH_HEALTH_WINDOW probes
+    uint32_t consecutiveFailures;  ///< Current run of lost probes
+    uint32_t rttLastUs;            ///< Last round-trip time (us)
+    uint32_t rttAvgUs;             ///< Average round-trip time (us)
+    uint32_t rttMinUs;             ///< Fastest round trip (us)
+    uint32_t rttMaxUs;             ///< Slowest round trip (us)
+};
+
+/**
+ * @brief Health monitor statistics
+ */
+struct HealthStats {
+    HealthProbeStats gateway;      ///< Default gateway probes
+    HealthProbeStats target;       ///< Optional configured target probes
+    uint32_t degradedEvents;       ///< HEALTHY -> DEGRADED transitions
+    uint32_t degradedMs;           ///< Total time spent DEGRADED (ms)
+    uint32_t probeIntervalMs;      ///< Current (adaptive) probe interval
+};
+
+/**
+ * @brief Link flap damping statistics
+ */
+struct FlapStats {
+    uint32_t flapCount;            ///< Link down edges seen by the driver
+    uint32_t suppressCount;        ///< Times the penalty crossed the suppress threshold
+    uint32_t currentPenalty;       ///< Decayed penalty now
+    uint32_t suppressedMs;         ///< Total time reports were held (ms)
+    bool suppressed;               ///< Link state reports currently held
+};
+
+/**
+ * @brief Short link blip statistics (grace-period holds)
+ *
+ * Histogram bucket upper bounds (ms): 100, 250, 500, 1000, 2000, 5000, 10000, above.
+ */
+struct BlipStats {
+    uint32_t holds;                ///< Disconnects that entered LINK_DOWN_HOLDING
+    uint32_t resumed;              ///< Holds resumed to CONNECTED without DHCP
+    uint32_t expired;              ///< Holds that outlived the grace period
+    uint32_t lastBlipMs;           ///< Duration of the last resumed blip
+    uint32_t maxBlipMs;            ///< Longest resumed blip
+    uint32_t histogram[8];         ///< Resumed blip durations by bucket
+};
+
+/**
+ * @brief Failover statistics structure
+ */
+struct FailoverStats {
+    uint32_t switchoverCount;    ///< Ethernet -> WiFi switchovers
+    uint32_t failbackCount;      ///< WiFi -> Ethernet returns
+    uint32_t failedSwitchovers;  ///< Link losses with no usable WiFi uplink
+    uint32_t lastSwitchoverUs;   ///< Link loss to default route on WiFi (us)
+    uint32_t maxSwitchoverUs;    ///< Worst switchover latency (us)
+    uint32_t lastFailbackUs;     ///< Route move back to Ethernet (us)
+    uint32_t wifiUplinkMs;       ///< Total time carried on WiFi (ms)
+};
+
+/**
+ * @brief Event dispatch statistics
+ */
+struct EventLoopStats {
+    bool privateLoop;            ///< Handlers run on the manager's own event loop
+    uint32_t forwarded;          ///< Events forwarded from the default loop
+    uint32_t dropped;            ///< Forwards lost to a full private queue
+    uint32_t dispatchLastUs;     ///< Default loop to private handler latency (us)
+    uint32_t dispatchAvgUs;      ///< Average forwarding latency (us)
+    uint32_t dispatchMaxUs;      ///< Worst forwarding latency (us)
+    uint32_t probeLastUs;        ///< Last measureEventDispatch() result (us)
+    uint32_t probeMaxUs;         ///< Worst measureEventDispatch() result (us)
+};
+
+/**
+ * @brief Result of MDIO PHY discovery
+ */
+struct EthPhyInfo {
+    int8_t address;              ///< MDIO address of the PHY (-1 if none answered)
+    uint16_t id1;                ///< PHY identifier register 2
+    uint16_t id2;                ///< PHY identifier register 3 (model and revision)
+    const char* model;           ///< Identified chip, "unknown" if not in the table
+    uint8_t found;               ///< PHYs that answered during the sweep
+    bool fromCache;              ///< Cached address confirmed without a sweep
+    uint32_t scanTimeUs;         ///< Time spent on discovery, EMAC setup included (us)
+};
+
+/**
+ * @brief Wake-on-LAN statistics
+ */
+struct WakeOnLanStats {
+    uint32_t suspends;             ///< Entries into SUSPENDED
+    uint32_t magicWakes;           ///< Resumes triggered by a matching magic packet
+    uint32_t spuriousWakes;        ///< Light-sleep wakes without a magic packet in the verify window
+    uint32_t lightSleeps;          ///< Light-sleep periods entered by waitForWake()
+    uint32_t framesDropped;        ///< Frames discarded by the filter while suspended
+    uint32_t suspendedMs;          ///< Total time in SUSPENDED (ms)
+};
+
+/**
+ * @brief EMAC address filter statistics
+ *
+ * Receive counters are frames the EMAC delivered to the driver; the ESP32
+ * EMAC has no counter for frames its filter rejected.
+ */
+struct MacFilterStats {
+    uint32_t rxUnicast;            ///< Unicast frames delivered to the stack
+    uint32_t rxMulticast;          ///< Multicast frames delivered to the stack
+    uint32_t rxBroadcast;          ///< Broadcast frames delivered to the stack
+    uint8_t filters;               ///< Addresses in the filter table
+    uint8_t hardwareSlots;         ///< Of those, held in EMAC perfect-filter slots
+    uint32_t overflows;            ///< Times the table outgrew the slots (pass-all-multicast)
+    bool multicastFiltered;        ///< Multicast limited to the table in hardware
+    bool broadcastDropped;         ///< Broadcast frames rejected in hardware
+    bool promiscuous;              ///< Every frame accepted
+};
+
+/**
+ * @brief PHY power state used for time-in-state accounting
+ */
+enum class EthPhyPowerState {
+    ACTIVE,            ///< Link up
+    NO_LINK,           ///< Powered and searching, no link
+    ENERGY_DETECT,     ///< No link, EDPWRDOWN armed: PHY idles until energy on the wire
+    POWER_DOWN         ///< Application low-power state (setPhyLowPower)
+};
+
+/**
+ * @brief PHY power management statistics
+ */
+struct EthPowerStats {
+    EthPhyPowerState state;        ///< Current power state
+    uint32_t activeMs;             ///< Total time with link up (ms)
+    uint32_t noLinkMs;             ///< Total time powered without link (ms)
+    uint32_t energyDetectMs;       ///< Total time in energy-detect power-down (ms)
+    uint32_t powerDownMs;          ///< Total time in the application low-power state (ms)
+    uint32_t lowPowerEntries;      ///< setPhyLowPower(true) transitions
+    bool energyDetect;             ///< EDPWRDOWN currently armed
+    bool eeeCapable;               ///< PHY reports 100BASE-TX EEE (MMD 3.20)
+    bool eeeAdvertised;            ///< 100BASE-TX EEE advertised (MMD 7.60)
+    bool eeePartner;               ///< Link partner advertises 100BASE-TX EEE (MMD 7.61)
 };
 
 /**
@@ -78,6 +428,9 @@ using EthConnectedCallback = std::function<void(IPAddress ip)>;
 using EthDisconnectedCallback = std::function<void(uint32_t duration)>;
 using EthStateChangeCallback = std::function<void(EthConnectionState oldState, EthConnectionState newState)>;
 using EthLinkStatusCallback = std::function<void(bool linkUp)>;
+using EthHealthCallback = std::function<void(EthHealth health)>;
+using EthSocketAbortCallback = std::function<void(uint32_t abortedCount)>;
+using EthBackoffFunction = std::function<uint32_t(uint8_t attempt, uint32_t previousDelayMs)>;
 
 /**
  * @brief Configuration builder for EthernetManager
@@ -135,6 +488,178 @@ public:
         return *this;
     }
     
+    EthernetConfig& withDhcpFallback(uint32_t dhcpTimeoutMs = ETH_DHCP_FALLBACK_TIMEOUT_MS,
+                                     bool autoIp = true,
+                                     uint32_t retryIntervalMs = ETH_DHCP_RETRY_INTERVAL_MS) {
+        dhcp_fallback_timeout = dhcpTimeoutMs;
+        fallback_autoip = autoIp;
+        dhcp_retry_interval = retryIntervalMs;
+        return *this;
+    }
+    
+    EthernetConfig& withFallbackStaticIP(IPAddress ip, IPAddress gw, IPAddress mask,
+                                         IPAddress dns = IPAddress()) {
+        fallback_ip = ip;
+        fallback_gateway = gw;
+        fallback_subnet = mask;
+        fallback_dns = dns;
+        return *this;
+    }
+    
+    EthernetConfig& withDhcpLeaseCache(bool enable = true) {
+        enable_lease_cache = enable;
+        return *this;
+    }
+    
+    EthernetConfig& withIPv6(EthIpReadyPolicy policy = EthIpReadyPolicy::EITHER) {
+        enable_ipv6 = true;
+        ready_policy = policy;
+        return *this;
+    }
+    
+    EthernetConfig& withReconnectBackoff(EthBackoffPolicy policy) {
+        backoff_policy = policy;
+        backoff_policy_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withLinkHoldGrace(uint32_t graceMs) {
+        link_hold_grace = graceMs;
+        link_hold_grace_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withStaticFastPath(bool enable = true) {
+        static_fast_path = enable;
+        static_fast_path_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withSocketAbort(bool enable = true) {
+        abort_sockets = enable;
+        abort_sockets_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withDhcpWatchdog(uint32_t timeoutMs) {
+        dhcp_watchdog_timeout = timeoutMs;
+        dhcp_watchdog_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withFlapDamping(bool enable = true,
+                                    uint32_t halfLifeMs = ETH_FLAP_HALF_LIFE_MS,
+                                    uint32_t suppressThreshold = ETH_FLAP_SUPPRESS_THRESHOLD,
+                                    uint32_t reuseThreshold = ETH_FLAP_REUSE_THRESHOLD) {
+        flap_damping = enable;
+        flap_half_life = halfLifeMs;
+        flap_suppress = suppressThreshold;
+        flap_reuse = reuseThreshold;
+        flap_damping_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withHealthMonitor(uint32_t intervalMs = ETH_HEALTH_INTERVAL_MS,
+                                      IPAddress target = IPAddress(),
+                                      uint32_t fastIntervalMs = ETH_HEALTH_FAST_INTERVAL_MS) {
+        enable_health_monitor = true;
+        health_interval = intervalMs;
+        health_fast_interval = fastIntervalMs;
+        health_target = target;
+        return *this;
+    }
+    
+    EthernetConfig& withArpPrewarm(bool gratuitousArp = true, bool resolveGateway = true) {
+        gratuitous_arp = gratuitousArp;
+        arp_resolve_gateway = resolveGateway;
+        arp_prewarm_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withArpPeer(IPAddress peer) {
+        if (arp_peer_count < ETH_MAX_ARP_PEERS) {
+            arp_peers[arp_peer_count++] = peer;
+        }
+        return *this;
+    }
+    
+    EthernetConfig& withWiFiFailover(const char* ssid, const char* password,
+                                     EthFailoverMode mode = EthFailoverMode::PRE_ASSOCIATED,
+                                     uint32_t returnStableMs = ETH_FAILOVER_RETURN_STABLE_MS) {
+        failover_ssid = ssid;
+        failover_password = password;
+        failover_mode = mode;
+        failover_return_stable_ms = returnStableMs;
+        return *this;
+    }
+    
+    EthernetConfig& withPrivateEventLoop(UBaseType_t priority = ETH_EVENT_LOOP_TASK_PRIORITY,
+                                         BaseType_t core = ETH_EVENT_LOOP_CORE,
+                                         uint16_t queueSize = ETH_EVENT_LOOP_QUEUE_SIZE) {
+        private_event_loop = true;
+        event_loop_priority = priority;
+        event_loop_core = core;
+        event_loop_queue = queueSize;
+        return *this;
+    }
+    
+    EthernetConfig& withPhyAutoDetect(bool enable = true) {
+        phy_auto_detect = enable;
+        return *this;
+    }
+    
+    EthernetConfig& withWarmStart(bool enable = true) {
+        warm_start = enable;
+        return *this;
+    }
+    
+    EthernetConfig& withWakeOnLan(int8_t wakePin = ETH_WOL_WAKE_PIN) {
+        wake_on_lan = true;
+        wol_wake_pin = wakePin;
+        return *this;
+    }
+    
+    EthernetConfig& withPhyPowerSave(bool eee = true, bool energyDetect = true) {
+        phy_eee = eee;
+        phy_energy_detect = energyDetect;
+        phy_power_save_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withMulticastFilter(bool enable = true) {
+        multicast_filter = enable;
+        multicast_filter_set = true;
+        return *this;
+    }
+    
+    EthernetConfig& withStormShedding(uint32_t broadcastPps = ETH_RX_BROADCAST_PPS,
+                                      uint32_t multicastPps = ETH_RX_MULTICAST_PPS,
+                                      bool dropForeignArp = true) {
+        storm_shedding = true;
+        storm_broadcast_pps = broadcastPps;
+        storm_multicast_pps = multicastPps;
+        storm_drop_foreign_arp = dropForeignArp;
+        return *this;
+    }
+    
+    EthernetConfig& withTrafficShaper(uint32_t linkKbps = 0) {
+        traffic_shaper = true;
+        shaper_link_kbps = linkKbps;
+        return *this;
+    }
+    
+    EthernetConfig& withVlan(uint16_t vid) {
+        vlan_id = vid;
+        return *this;
+    }
+    
+    EthernetConfig& withVirtualVlan(uint16_t vid) {
+        if (virtual_vlan_count < ETH_MAX_VLANS) {
+            virtual_vlans[virtual_vlan_count++] = vid;
+        }
+        return *this;
+    }
+    
 private:
     friend class EthernetManager;
     const char* hostname;
@@ -156,8 +681,72 @@ private:
     uint8_t reconnect_max_retries;
     uint32_t reconnect_initial_delay;
     uint32_t reconnect_max_delay;
+    bool enable_lease_cache = false;
+    uint32_t dhcp_fallback_timeout = 0;
+    bool fallback_autoip = true;
+    uint32_t dhcp_retry_interval = ETH_DHCP_RETRY_INTERVAL_MS;
+    IPAddress fallback_ip;
+    IPAddress fallback_gateway;
+    IPAddress fallback_subnet;
+    IPAddress fallback_dns;
+    EthBackoffPolicy backoff_policy = EthBackoffPolicy::EXPONENTIAL;
+    // The *_set flags mark settings the builder touched; the rest keep
+    // whatever was set at runtime before initialize(config)
+    bool backoff_policy_set = false;
+    uint32_t link_hold_grace = ETH_LINK_HOLD_GRACE_MS;
+    bool link_hold_grace_set = false;
+    bool static_fast_path = ETH_STATIC_FAST_PATH;
+    bool static_fast_path_set = false;
+    bool abort_sockets = ETH_ABORT_SOCKETS_ON_DISCONNECT;
+    bool abort_sockets_set = false;
+    uint32_t dhcp_watchdog_timeout = ETH_DHCP_WATCHDOG_MS;
+    bool dhcp_watchdog_set = false;
+    bool flap_damping = ETH_ENABLE_FLAP_DAMPING;
+    bool flap_damping_set = false;
+    uint32_t flap_half_life = ETH_FLAP_HALF_LIFE_MS;
+    uint32_t flap_suppress = ETH_FLAP_SUPPRESS_THRESHOLD;
+    uint32_t flap_reuse = ETH_FLAP_REUSE_THRESHOLD;
+    bool enable_health_monitor = false;
+    uint32_t health_interval = ETH_HEALTH_INTERVAL_MS;
+    uint32_t health_fast_interval = ETH_HEALTH_FAST_INTERVAL_MS;
+    IPAddress health_target;
+    bool gratuitous_arp = ETH_ENABLE_ARP_PREWARM;
+    bool arp_resolve_gateway = ETH_ENABLE_ARP_PREWARM;
+    bool arp_prewarm_set = false;
+    IPAddress arp_peers[ETH_MAX_ARP_PEERS];
+    uint8_t arp_peer_count = 0;
+    bool enable_ipv6 = false;
+    EthIpReadyPolicy ready_policy = EthIpReadyPolicy::IPV4;
+    const char* failover_ssid = nullptr;
+    const char* failover_password = nullptr;
+    EthFailoverMode failover_mode = EthFailoverMode::PRE_ASSOCIATED;
+    uint32_t failover_return_stable_ms = ETH_FAILOVER_RETURN_STABLE_MS;
+    bool private_event_loop = ETH_PRIVATE_EVENT_LOOP;
+    UBaseType_t event_loop_priority = ETH_EVENT_LOOP_TASK_PRIORITY;
+    BaseType_t event_loop_core = ETH_EVENT_LOOP_CORE;
+    uint16_t event_loop_queue = ETH_EVENT_LOOP_QUEUE_SIZE;
+    bool phy_auto_detect = ETH_PHY_AUTO_DETECT;
+    bool warm_start = ETH_WARM_START;
+    bool wake_on_lan = false;
+    int8_t wol_wake_pin = ETH_WOL_WAKE_PIN;
+    bool phy_eee = ETH_PHY_EEE;
+    bool phy_energy_detect = ETH_PHY_ENERGY_DETECT;
+    bool phy_power_save_set = false;
+    bool multicast_filter = ETH_HW_MULTICAST_FILTER;
+    bool multicast_filter_set = false;
+    bool storm_shedding = false;
+    uint32_t storm_broadcast_pps = ETH_RX_BROADCAST_PPS;
+    uint32_t storm_multicast_pps = ETH_RX_MULTICAST_PPS;
+    bool storm_drop_foreign_arp = true;
+    bool traffic_shaper = false;
+    uint32_t shaper_link_kbps = 0;
+    uint16_t vlan_id = 0;
+    uint16_t virtual_vlans[ETH_MAX_VLANS] = {};
+    uint8_t virtual_vlan_count = 0;
 };
 
+struct pbuf;
+
 /**
  * @brief A manager class for ESP32 Ethernet connectivity using LAN8720A PHY
  *
@@ -219,7 +808,7 @@ public:
     [[nodiscard]] static EthResult<void> initializeAsync(const EthernetConfig& config);
     
     /**
-     * @brief Perform early initialization before ETH.begin()
+     * @brief Perform early initialization before the Ethernet driver starts
      * 
      * This method sets up event handlers and event groups before starting
      * the Ethernet PHY. Call this early in setup() for best performance.
@@ -407,6 +996,11 @@ public:
      * @return String representation of state
      */
     static const char* stateToString(EthConnectionState state);
+
+    /**
+     * @brief Name of the compiled-in driver backend (see ETH_BACKEND_NATIVE)
+     */
+    static const char* getBackendName() { return EthBackend::NAME; }
     
     /**
      * @brief Get network statistics
@@ -431,6 +1025,52 @@ public:
     static void setAutoReconnect(bool enable, uint8_t maxRetries = 0, 
                                 uint32_t initialDelayMs = 1000, uint32_t maxDelayMs = 30000);
     
+    /**
+     * @brief Select the delay policy between reconnect attempts
+     *
+     * Jittered policies draw from a PRNG seeded with the MAC address, so a
+     * site-wide power cycle does not line hundreds of devices up on the
+     * same DHCP retry schedule.
+     *
+     * @param policy Built-in policy (CUSTOM requires the function overload)
+     */
+    static void setReconnectBackoff(EthBackoffPolicy policy);
+
+    /**
+     * @brief Use a custom delay function between reconnect attempts
+     *
+     * @param fn Returns the next delay from the attempt number (1-based) and
+     *           previous delay; the result is clamped to the configured max delay.
+     *           nullptr goes back to EXPONENTIAL.
+     */
+    static void setReconnectBackoff(EthBackoffFunction fn);
+
+    /**
+     * @brief Configure the OBTAINING_IP watchdog
+     *
+     * If the manager stays in OBTAINING_IP for timeoutMs, the DHCP client
+     * is restarted; every further expiry escalates through the recovery
+     * ladder (driver restart, PHY power cycle, netif recreate).
+     *
+     * @param timeoutMs Time allowed in OBTAINING_IP (0 disables)
+     */
+    static void setDhcpWatchdog(uint32_t timeoutMs);
+
+    /**
+     * @brief Get the recovery step the last reconnect attempt took
+     *
+     * @return EthRecoveryAction
+     */
+    static EthRecoveryAction getLastRecoveryAction() { return getInstance().lastRecoveryAction; }
+
+    /**
+     * @brief Convert recovery action to string
+     *
+     * @param action Action to convert
+     * @return String representation of action
+     */
+    static const char* recoveryActionToString(EthRecoveryAction action);
+
     /**
      * @brief Get last error code
      *
@@ -461,6 +1101,95 @@ public:
      */
     static void setLinkMonitoring(bool enable, uint32_t intervalMs = 1000);
     
+    /**
+     * @brief Retain the address across short link blips
+     *
+     * A disconnect while CONNECTED enters LINK_DOWN_HOLDING instead of
+     * LINK_DOWN: the address and lease are kept and no disconnect callback
+     * fires. If the link returns within graceMs the address is restored on
+     * the netif at once and the state goes straight back to CONNECTED; the
+     * restarted DHCP client confirms or replaces the lease in the background.
+     * Otherwise the disconnect is reported when the grace period ends.
+     *
+     * @param graceMs Grace period (0 disables holding)
+     */
+    static void setLinkHoldGrace(uint32_t graceMs);
+
+    /**
+     * @brief Get short link blip statistics
+     *
+     * @return BlipStats structure
+     */
+    static BlipStats getBlipStats();
+
+    /**
+     * @brief Report CONNECTED at link up when using a static IP
+     *
+     * The static address is on the netif before the link comes up, so
+     * waiting for esp_netif's GOT_IP event only adds event-loop latency.
+     * When enabled, link up with a static IP brings the lwIP netif up,
+     * announces the address and reports CONNECTED immediately; the lead
+     * over the later GOT_IP event is reported in PerformanceMetrics.
+     *
+     * @param enable true to report CONNECTED at link up
+     */
+    static void setStaticFastPath(bool enable);
+
+    /**
+     * @brief Abort TCP connections when a disconnect is confirmed
+     *
+     * Without this, connections on a static address outlive the link and
+     * only fail after lwIP's retransmission timeouts. When enabled, every
+     * active TCP PCB bound to the Ethernet address or netif is aborted as
+     * the state machine reports the disconnect, so blocked socket calls
+     * return ECONNABORTED at once.
+     *
+     * @param enable true to abort connections on disconnect
+     */
+    static void setSocketAbortOnDisconnect(bool enable);
+
+    /**
+     * @brief Set callback for socket owners on confirmed disconnect
+     *
+     * Called before the disconnected callback with the number of TCP
+     * connections aborted (0 when aborting is disabled), so clients that
+     * keep their own sockets can drop and reopen them.
+     *
+     * @param callback Function to call
+     */
+    static void setSocketAbortCallback(EthSocketAbortCallback callback);
+
+    /**
+     * @brief Configure link flap damping (BGP-style)
+     *
+     * Every link down adds ETH_FLAP_PENALTY to a penalty that halves every
+     * halfLifeMs. Above suppressThreshold the manager stops reporting link
+     * and connection changes (the state stays LINK_DOWN) until the penalty
+     * has decayed below reuseThreshold, then reports the current state.
+     *
+     * @param enable Enable or disable damping
+     * @param halfLifeMs Penalty half-life
+     * @param suppressThreshold Penalty at which reports are held
+     * @param reuseThreshold Penalty below which reports resume
+     */
+    static void setFlapDamping(bool enable, uint32_t halfLifeMs = ETH_FLAP_HALF_LIFE_MS,
+                               uint32_t suppressThreshold = ETH_FLAP_SUPPRESS_THRESHOLD,
+                               uint32_t reuseThreshold = ETH_FLAP_REUSE_THRESHOLD);
+
+    /**
+     * @brief Get link flap damping statistics
+     *
+     * @return FlapStats structure
+     */
+    static FlapStats getFlapStats();
+
+    /**
+     * @brief Check whether link reports are held by flap damping
+     *
+     * @return true while suppressed
+     */
+    static bool isLinkSuppressed() { return getInstance().linkSuppressed; }
+
     /**
      * @brief Force a link status check
      * 
@@ -514,7 +1243,7 @@ public:
      *
      * @return true if physical link is up
      */
-    static bool isLinkUp() { return getInstance().phyStarted && ETH.linkUp(); }
+    static bool isLinkUp() { return getInstance().phyStarted && EthBackend::linkUp(); }
     
     /**
      * @brief Get connection uptime in milliseconds
@@ -573,6 +1302,14 @@ public:
     static bool getPerformanceMetrics(uint32_t& initTimeMs, uint32_t& linkUpTimeMs, 
                                     uint32_t& ipObtainTimeMs, uint32_t& eventCount);
     
+    /**
+     * @brief Get extended performance metrics
+     * 
+     * @param metrics Output structure
+     * @return true if metrics are available
+     */
+    static bool getPerformanceMetrics(PerformanceMetrics& metrics);
+    
     /**
      * @brief Set verbose logging mode
      * 
@@ -593,22 +1330,718 @@ public:
      */
     void setStatusLogLevel(esp_log_level_t level);
 
-private:
     /**
-     * @brief Private constructor for singleton pattern
+     * @brief Configure the fallback chain used when DHCP does not answer
+     *
+     * If no lease is bound within dhcpTimeoutMs of link up, the fallback
+     * static address (if set) and then a 169.254/16 AutoIP address are tried,
+     * each ARP-probed for conflicts. While on a fallback address a DHCP
+     * DISCOVER probe is sent every retryIntervalMs; on an OFFER the DHCP
+     * client is restarted.
+     *
+     * @param dhcpTimeoutMs DHCP timeout before falling back (0 disables)
+     * @param autoIp Use AutoIP when no static fallback is usable
+     * @param retryIntervalMs Interval between background DHCP probes
+     * @param ip Fallback static address (IPAddress() to skip)
+     * @param gw Fallback gateway
+     * @param mask Fallback subnet mask
+     * @param dns Fallback DNS server (optional)
      */
-    EthernetManager();
+    static void setDhcpFallback(uint32_t dhcpTimeoutMs, bool autoIp = true,
+                                uint32_t retryIntervalMs = ETH_DHCP_RETRY_INTERVAL_MS,
+                                IPAddress ip = IPAddress(), IPAddress gw = IPAddress(),
+                                IPAddress mask = IPAddress(), IPAddress dns = IPAddress());
 
     /**
-     * @brief Destructor
+     * @brief Get the source of the current IPv4 address
+     *
+     * @return EthAddressSource
      */
-    ~EthernetManager();
+    static EthAddressSource getAddressSource() { return getInstance().addressSource; }
 
     /**
-     * @brief Event handler for Ethernet and IP events
-     */
+     * @brief Start the layer-3 health monitor
+     *
+     * While CONNECTED, the default gateway (and target, if set) is probed
+     * with ICMP echo. After ETH_HEALTH_FAIL_THRESHOLD consecutive losses the
+     * health becomes DEGRADED even though the link and address remain; it
+     * returns to HEALTHY after ETH_HEALTH_RECOVER_THRESHOLD good rounds.
+     * Probing runs at fastIntervalMs after a loss and backs off to
+     * intervalMs while everything answers.
+     *
+     * @param intervalMs Probe interval while healthy
+     * @param target Additional destination to probe (IPAddress() for gateway only)
+     * @param fastIntervalMs Probe interval after a loss
+     * @return true if the monitor task is running
+     */
+    static bool enableHealthMonitor(uint32_t intervalMs = ETH_HEALTH_INTERVAL_MS,
+                                    IPAddress target = IPAddress(),
+                                    uint32_t fastIntervalMs = ETH_HEALTH_FAST_INTERVAL_MS);
+
+    /**
+     * @brief Stop the health monitor
+     */
+    static void disableHealthMonitor();
+
+    /**
+     * @brief Get the current layer-3 health
+     *
+     * @return EthHealth (UNKNOWN when the monitor is off or not connected)
+     */
+    static EthHealth getHealth() { return getInstance().health; }
+
+    /**
+     * @brief Check whether traffic can be expected to route
+     *
+     * @return true if connected and the health monitor does not report DEGRADED
+     */
+    static bool isNetworkHealthy() { return isConnected() && getInstance().health != EthHealth::DEGRADED; }
+
+    /**
+     * @brief Get health monitor statistics
+     *
+     * @return HealthStats structure
+     */
+    static HealthStats getHealthStats();
+
+    /**
+     * @brief Set callback for health changes
+     *
+     * @param callback Function to call on HEALTHY / DEGRADED / UNKNOWN transitions
+     */
+    static void setHealthCallback(EthHealthCallback callback);
+
+    /**
+     * @brief Configure ARP work done when an IPv4 address is assigned
+     *
+     * Gratuitous ARP refreshes stale entries our peers hold for the address
+     * (e.g. after failover); resolving the gateway and configured peers up
+     * front means the first application packet leaves without an ARP round
+     * trip. Resolution latency is reported in getPerformanceMetrics().
+     *
+     * @param gratuitousArp Announce the address ETH_GARP_COUNT times
+     * @param resolveGateway Resolve the default gateway
+     */
+    static void setArpPrewarm(bool gratuitousArp, bool resolveGateway);
+
+    /**
+     * @brief Add a peer resolved together with the gateway on connect
+     *
+     * @param peer IPv4 address on the local subnet
+     * @return false if ETH_MAX_ARP_PEERS peers are already configured
+     */
+    static bool addArpPeer(IPAddress peer);
+
+    /**
+     * @brief Remove all ARP prewarm peers
+     */
+    static void clearArpPeers();
+
+    /**
+     * @brief Enable DHCP fast reconnect from a persisted lease
+     *
+     * The lease bound on IP_EVENT_ETH_GOT_IP is stored in NVS. With
+     * CONFIG_LWIP_DHCP_RESTORE_LAST_IP, IDF's lwIP requests the last address
+     * directly (INIT-REBOOT) instead of running DISCOVER/OFFER, and a NAK falls
+     * back to full discovery. getPerformanceMetrics() counts a link-to-IP as
+     * cached when the client was seen in INIT-REBOOT and bound the address it
+     * requested. Without that option nothing requests the stored lease, so
+     * enabling fails with EthError::CONFIG_FAILED.
+     *
+     * @param enable Enable or disable the lease cache
+     */
+    static void setDhcpLeaseCache(bool enable);
+
+    /**
+     * @brief Erase the persisted DHCP lease
+     */
+    static void clearDhcpLeaseCache();
+
+    /**
+     * @brief Enable IPv6 and select the readiness policy
+     *
+     * When enabled, a link-local address is created on link up and SLAAC /
+     * DHCPv6 addresses are tracked from IP_EVENT_GOT_IP6. The policy decides
+     * which address families must be present before CONNECTED is reported.
+     * Call before initialize() to catch the first link up.
+     *
+     * @param enable Enable IPv6 on the Ethernet netif
+     * @param policy Readiness policy (ignored and reset to IPV4 when disabled)
+     */
+    static void setIPv6(bool enable, EthIpReadyPolicy policy = EthIpReadyPolicy::EITHER);
+
+    /**
+     * @brief Get IPv6 addresses currently assigned to the Ethernet netif
+     *
+     * @param addrs Output array
+     * @param maxAddrs Capacity of addrs
+     * @return Number of addresses written
+     */
+    static uint8_t getIPv6Addresses(esp_ip6_addr_t* addrs, uint8_t maxAddrs);
+
+    /**
+     * @brief Check if a routable (global or unique-local) IPv6 address is assigned
+     *
+     * @return true if a routable IPv6 address is present
+     */
+    static bool hasRoutableIPv6();
+
+    /**
+     * @brief Enable Ethernet -> WiFi STA failover
+     *
+     * Brings up a standby WiFi station. When the state machine reports
+     * LINK_DOWN the default route is moved to the WiFi netif; once Ethernet
+     * has been CONNECTED for returnStableMs it is moved back. In
+     * PRE_ASSOCIATED mode the switchover is only a route change (sub-ms);
+     * FAST_CONNECT saves power but adds association and DHCP time.
+     * Requires ETH_ENABLE_WIFI_FAILOVER=1.
+     *
+     * @param ssid Standby network SSID
+     * @param password Standby network password (nullptr for open networks)
+     * @param mode Standby mode
+     * @param returnStableMs Time Ethernet must stay connected before failback
+     * @return true if the standby station was started
+     */
+    static bool enableFailover(const char* ssid, const char* password,
+                               EthFailoverMode mode = EthFailoverMode::PRE_ASSOCIATED,
+                               uint32_t returnStableMs = ETH_FAILOVER_RETURN_STABLE_MS);
+
+    /**
+     * @brief Disable failover, returning the default route to Ethernet
+     */
+    static void disableFailover();
+
+    /**
+     * @brief Get the uplink currently carrying the default route
+     *
+     * @return Active EthUplink
+     */
+    static EthUplink getActiveUplink() { return getInstance().activeUplink; }
+
+    /**
+     * @brief Get failover statistics including switchover latency
+     *
+     * @return FailoverStats structure with current statistics
+     */
+    static FailoverStats getFailoverStats();
+
+    /**
+     * @brief Run the manager's event handlers on a private event loop
+     *
+     * Ethernet and IP events are still posted to the default loop by the
+     * driver and esp_netif; a small forwarder there copies only the events
+     * the manager handles into a dedicated loop with its own task, so state
+     * handling and user callbacks neither wait behind nor delay WiFi/BT
+     * handlers. Takes effect immediately, but is best called before
+     * initialize().
+     *
+     * @param enable true for a private loop, false for the default loop
+     * @param priority Private loop task priority
+     * @param core Core affinity (tskNO_AFFINITY for either)
+     * @param queueSize Private loop queue length
+     * @return true on success
+     */
+    static bool setPrivateEventLoop(bool enable,
+                                    UBaseType_t priority = ETH_EVENT_LOOP_TASK_PRIORITY,
+                                    BaseType_t core = ETH_EVENT_LOOP_CORE,
+                                    uint16_t queueSize = ETH_EVENT_LOOP_QUEUE_SIZE);
+
+    /**
+     * @brief Measure post-to-handler latency of the loop running the handlers
+     *
+     * Posts a probe event to the active loop (default or private) and waits
+     * for the manager's handler to receive it; compare both modes under load.
+     *
+     * @param latencyUs Receives the dispatch latency in microseconds
+     * @param timeoutMs Maximum wait for the probe
+     * @return true if the probe was dispatched in time
+     */
+    static bool measureEventDispatch(uint32_t& latencyUs, uint32_t timeoutMs = 100);
+
+    /**
+     * @brief Get event forwarding and dispatch statistics
+     *
+     * @return EventLoopStats structure
+     */
+    static EventLoopStats getEventLoopStats();
+
+    /**
+     * @brief Find the PHY on the MDIO bus and store its address in a config
+     *
+     * Brings up only the EMAC's SMI interface (no driver install) and reads
+     * the PHY identifier registers at every address 0-31 in one sweep. The
+     * result is cached in NVS; on the next boot the cached address is
+     * confirmed with a single read and the sweep is skipped. Must run
+     * before initialize(), which does this itself with withPhyAutoDetect().
+     *
+     * @param config Pins and clock mode to use; phy_addr is updated on success
+     * @param info Optional output with the chip identity and scan time
+     * @return true if a PHY answered
+     */
+    static bool detectPhy(EthernetConfig& config, EthPhyInfo* info = nullptr);
+
+    /**
+     * @brief Get the result of the last PHY discovery
+     */
+    static EthPhyInfo getPhyInfo() { return getInstance().phyInfo; }
+
+    /**
+     * @brief Forget the cached PHY address so the next discovery sweeps
+     */
+    static void clearPhyCache();
+
+    /**
+     * @brief Keep the PHY's negotiated link across esp_restart()
+     *
+     * A shutdown handler holds the PHY power pin and records the PHY in RTC
+     * memory. After a software reset, initialization checks the PHY's basic
+     * status register over MDIO; with link and autonegotiation still good it
+     * starts the driver without the power-pin toggle or PHY reset, so the
+     * link comes up without renegotiating. Any other reset starts cold.
+     *
+     * @param enable true to keep the PHY state on software resets
+     */
+    static void setWarmStart(bool enable);
+
+    /**
+     * @brief Check whether this boot kept the PHY's link from before esp_restart()
+     */
+    static bool isWarmBoot() { return getInstance().warmBoot; }
+
+    /**
+     * @brief Save the manager's state to RTC memory before deep sleep
+     *
+     * Stores the custom MAC, PHY address, current DHCP lease and statistics.
+     * On wake, initialize() restores them: PHY discovery is skipped, stats
+     * carry on, and a lease still inside its renewal time is put back on the
+     * netif at link up while DHCP confirms it (older leases wait for DHCP). Call right before esp_deep_sleep_start().
+     *
+     * @param keepPhyPowered Also hold the PHY power pin through sleep so the
+     *        link survives (requires setWarmStart(true))
+     * @return true if the snapshot was saved
+     */
+    static bool prepareForSleep(bool keepPhyPowered = false);
+
+    /**
+     * @brief Check whether this wake restored the deep-sleep snapshot
+     */
+    static bool isSleepResume() { return getInstance().sleepResumed; }
+
+    /**
+     * @brief Select the PHY power-saving features
+     *
+     * Energy-detect power-down (LAN87xx EDPWRDOWN) lets the PHY idle its
+     * analog front end while no cable energy is seen and wake on the first
+     * link pulse. EEE is advertised only when the PHY reports the capability
+     * in MMD 3.20; changing the advertisement restarts autonegotiation.
+     * Both are reapplied on every driver start.
+     *
+     * @param eee Advertise Energy Efficient Ethernet where supported
+     * @param energyDetect Arm energy-detect power-down
+     */
+    static void setPhyPowerPolicy(bool eee, bool energyDetect);
+
+    /**
+     * @brief Enter or leave the application low-power state
+     *
+     * Stops the driver and powers the PHY off through the power pin, or
+     * sets the BMCR power-down bit when no pin is configured. The disconnect
+     * is reported at once, without the hold grace period, and no reconnect
+     * or recovery runs until the state is left. Leaving powers the PHY up
+     * and restarts the driver and autonegotiation.
+     *
+     * @param enable true to power the PHY down
+     * @return true if the PHY is in the requested state
+     */
+    static bool setPhyLowPower(bool enable);
+
+    /**
+     * @brief Check whether the application low-power state is active
+     */
+    static bool isPhyLowPower() { return getInstance().phyLowPower; }
+
+    /**
+     * @brief Get PHY power statistics, with time-in-state up to now
+     *
+     * @return EthPowerStats structure
+     */
+    static EthPowerStats getPowerStats();
+
+    /**
+     * @brief Convert PHY power state to string
+     *
+     * @param state State to convert
+     * @return String representation of state
+     */
+    static const char* powerStateToString(EthPhyPowerState state);
+
+    /**
+     * @brief Enable Wake-on-LAN suspend
+     *
+     * The EMAC and PHY stay powered while SUSPENDED; a filter on the driver's
+     * receive path drops every frame before lwIP except magic packets
+     * (sync stream plus 16 copies of our MAC, in any EtherType or UDP
+     * payload). A match resumes the manager.
+     *
+     * @param enable Enable or disable Wake-on-LAN
+     * @param wakePin GPIO wired to the PHY interrupt/PME output; lets
+     *        waitForWake() light-sleep the CPU (-1 keeps the CPU awake)
+     */
+    static void setWakeOnLan(bool enable, int8_t wakePin = ETH_WOL_WAKE_PIN);
+
+    /**
+     * @brief Enter SUSPENDED and arm the magic packet filter
+     *
+     * isConnected() reports false and no traffic reaches lwIP until a magic
+     * packet arrives or resume() is called. The address is kept.
+     *
+     * @return true if the manager is suspended
+     */
+    static bool suspend();
+
+    /**
+     * @brief Leave SUSPENDED without a magic packet
+     *
+     * @return true if the manager was suspended
+     */
+    static bool resume();
+
+    /**
+     * @brief Block until a magic packet resumes the manager
+     *
+     * With a wake pin the CPU light-sleeps until the pin fires, then gives
+     * the EMAC ETH_WOL_VERIFY_MS to deliver a matching frame; wakes without
+     * one are counted as spurious and the CPU goes back to sleep.
+     *
+     * @param timeoutMs Maximum time to wait (portMAX_DELAY waits forever)
+     * @return true if a magic packet arrived
+     */
+    static bool waitForWake(uint32_t timeoutMs = portMAX_DELAY);
+
+    /**
+     * @brief Get Wake-on-LAN statistics
+     *
+     * @return WakeOnLanStats structure
+     */
+    static WakeOnLanStats getWakeOnLanStats();
+
+    /**
+     * @brief Enable hardware multicast filtering
+     *
+     * Multicast groups joined through lwIP (IGMP/MLD, including the all-hosts
+     * and solicited-node groups) and addresses added with addMacFilter() are
+     * programmed into the EMAC perfect-filter slots, so other multicast never
+     * reaches the CPU. With more addresses than slots the EMAC falls back to
+     * passing all multicast until the table shrinks again.
+     *
+     * ESP32 EMAC only: the registers are written directly (esp_eth has no
+     * filter API) and reprogrammed on every ETHERNET_EVENT_START.
+     *
+     * @param enable Enable or disable the filter
+     * @return true if applied
+     */
+    static bool setMulticastFilter(bool enable);
+
+    /**
+     * @brief Join an IPv4 multicast group on the Ethernet interface
+     *
+     * @param group Group address (224.0.0.0/4)
+     * @return true if joined
+     */
+    static bool joinMulticastGroup(IPAddress group);
+
+    /**
+     * @brief Leave an IPv4 multicast group joined with joinMulticastGroup()
+     *
+     * @param group Group address
+     * @return true if left
+     */
+    static bool leaveMulticastGroup(IPAddress group);
+
+    /**
+     * @brief Accept frames for an extra destination MAC address
+     *
+     * @param mac Address to add (6 bytes); adds are reference counted
+     * @return true if added
+     */
+    static bool addMacFilter(const uint8_t* mac);
+
+    /**
+     * @brief Remove an address added with addMacFilter()
+     *
+     * @param mac Address to remove (6 bytes)
+     * @return true if removed
+     */
+    static bool removeMacFilter(const uint8_t* mac);
+
+    /**
+     * @brief Drop broadcast frames in the EMAC
+     *
+     * The filter is all-or-nothing: ARP requests and broadcast DHCP replies
+     * are dropped too, so only use this with static ARP entries and a
+     * static address or unicast DHCP.
+     *
+     * @param drop Drop (true) or accept (false) broadcast
+     * @return true if applied
+     */
+    static bool setBroadcastFilter(bool drop);
+
+    /**
+     * @brief Accept every frame regardless of destination address
+     *
+     * @param enable Enable or disable promiscuous mode
+     * @return true if applied
+     */
+    static bool setPromiscuous(bool enable);
+
+    /**
+     * @brief Get EMAC address filter statistics
+     *
+     * @return MacFilterStats structure
+     */
+    static MacFilterStats getMacFilterStats();
+
+    /**
+     * @brief Enable the receive classifier
+     *
+     * Frames are checked against the rules on the EMAC receive task, before
+     * a pbuf is allocated or anything is queued to the tcpip thread. The
+     * first matching rule decides: a frame passes while the rule's token
+     * bucket has a token and is freed otherwise. ARP requests for our own
+     * address always pass. Drops are counted in NetworkStats.
+     *
+     * @param enable Enable or disable the classifier
+     */
+    static void setRxClassifier(bool enable);
+
+    /**
+     * @brief Append a receive classifier rule
+     *
+     * @param match Frame class the rule applies to
+     * @param ratePps Frames per second let through (0 drops every match)
+     * @param burst Bucket depth in frames
+     * @param etherType EtherType for EthRxMatch::ETHERTYPE rules
+     * @return true if added, false if ETH_MAX_RX_RULES are in use
+     */
+    static bool addRxRule(EthRxMatch match, uint32_t ratePps, uint16_t burst = ETH_RX_BURST,
+                          uint16_t etherType = 0);
+
+    /**
+     * @brief Remove all receive classifier rules
+     */
+    static void clearRxRules();
+
+    /**
+     * @brief Replace the rules with a broadcast storm profile and enable them
+     *
+     * Drops ARP requests for other hosts (gratuitous ARP still passes) and
+     * rate-limits broadcast and multicast. lwIP no longer refreshes cached
+     * neighbours from requests they send to others.
+     *
+     * @param broadcastPps Broadcast frames per second let through
+     * @param multicastPps Multicast frames per second let through
+     * @param dropForeignArp Drop ARP requests for other hosts
+     */
+    static void setStormShedding(uint32_t broadcastPps = ETH_RX_BROADCAST_PPS,
+                                 uint32_t multicastPps = ETH_RX_MULTICAST_PPS,
+                                 bool dropForeignArp = true);
+
+    /**
+     * @brief Enable the traffic shaper
+     *
+     * Outgoing frames are classified and sent at once while their class
+     * (and the link) has tokens. Otherwise they wait in the class queue,
+     * and queues are served highest class first. A full queue refuses the
+     * frame with ERR_MEM, so TCP keeps the segment and retries. Incoming
+     * frames over a class's ingress limit are dropped before lwIP.
+     *
+     * @param enable Enable or disable; disabling sends what is queued
+     */
+    static void setTrafficShaper(bool enable);
+
+    /**
+     * @brief Set the token-bucket limits of one class
+     *
+     * @param cls Traffic class
+     * @param egressKbps Transmit limit in kbit/s (0 = unlimited)
+     * @param ingressKbps Receive limit in kbit/s (0 = unlimited)
+     * @param burstBytes Bucket depth, at least one full frame
+     */
+    static void setTrafficClassRate(EthTrafficClass cls, uint32_t egressKbps, uint32_t ingressKbps = 0,
+                                    uint32_t burstBytes = ETH_SHAPER_BURST_BYTES);
+
+    /**
+     * @brief Limit total egress; classes then share it in strict priority
+     *
+     * @param kbps Link limit in kbit/s (0 = unlimited)
+     * @param burstBytes Bucket depth, at least one full frame
+     */
+    static void setShaperLinkRate(uint32_t kbps, uint32_t burstBytes = ETH_SHAPER_BURST_BYTES);
+
+    /**
+     * @brief Append a classification rule; the first match wins
+     *
+     * @param match Field to match
+     * @param value DSCP value, port number or EtherType
+     * @param cls Class for matching frames
+     * @return true if added, false if ETH_MAX_TRAFFIC_RULES are in use
+     */
+    static bool addTrafficRule(EthTrafficMatch match, uint16_t value, EthTrafficClass cls);
+
+    /**
+     * @brief Remove all classification rules
+     */
+    static void clearTrafficRules();
+
+    /**
+     * @brief Get statistics for one traffic class
+     *
+     * @param cls Traffic class
+     * @return TrafficClassStats structure
+     */
+    static TrafficClassStats getTrafficClassStats(EthTrafficClass cls);
+
+    /**
+     * @brief Convert traffic class to string
+     *
+     * @param cls Class to convert
+     * @return String representation of class
+     */
+    static const char* trafficClassToString(EthTrafficClass cls);
+
+    /**
+     * @brief Tag the Ethernet interface's traffic with an 802.1Q VLAN id
+     *
+     * Outgoing frames get the tag, with the priority code point taken from
+     * the frame's traffic class. Incoming frames with the tag are untagged
+     * before lwIP. Untagged frames and frames for other VLANs are dropped.
+     *
+     * @param vid VLAN id 1-4094, or 0 for an untagged interface
+     * @return true if applied
+     */
+    static bool setVlan(uint16_t vid);
+
+    /**
+     * @brief Add a virtual interface on another VLAN
+     *
+     * The interface shares the MAC and the link, runs its own DHCP client
+     * and follows the link state. It is created at the next driver start,
+     * or at once if the driver is running, and lives until cleanup().
+     *
+     * @param vid VLAN id 1-4094
+     * @return true if added
+     */
+    static bool addVlanInterface(uint16_t vid);
+
+    /**
+     * @brief Get the netif of a virtual VLAN interface
+     *
+     * @param vid VLAN id
+     * @return The interface, or nullptr if not created (yet)
+     */
+    static esp_netif_t* getVlanInterface(uint16_t vid);
+
+    /**
+     * @brief Map a traffic class to an 802.1p priority code point
+     *
+     * Defaults: CONTROL 6, HIGH 4, NORMAL 0, BULK 1.
+     *
+     * @param cls Traffic class (see addTrafficRule())
+     * @param pcp Priority code point 0-7
+     */
+    static void setVlanPriority(EthTrafficClass cls, uint8_t pcp);
+
+    /**
+     * @brief Get counters for one VLAN
+     *
+     * @param vid VLAN id of the Ethernet interface or a virtual interface
+     * @return VlanStats structure (vid 0 if the VLAN is not configured)
+     */
+    static VlanStats getVlanStats(uint16_t vid);
+
+    /**
+     * @brief Start an iperf-style throughput benchmark on the Ethernet interface
+     *
+     * Runs in its own task; poll getBenchmarkResult() or block in
+     * waitForBenchmark(). Clients need CONNECTED and a peer. Servers take
+     * one client and end when it finishes, or after durationSec if set.
+     * iperf 2 works as the peer on a PC.
+     *
+     * @param mode Role and transport
+     * @param peer Server address for the client modes
+     * @param port TCP/UDP port
+     * @param durationSec Client send time; server limit (0 = until the client ends)
+     * @param udpKbps UDP client send rate (0 = as fast as possible)
+     * @return true if the benchmark task was started
+     */
+    static bool startBenchmark(EthBenchmarkMode mode, IPAddress peer = IPAddress(),
+                               uint16_t port = ETH_BENCH_PORT,
+                               uint32_t durationSec = ETH_BENCH_DURATION_S,
+                               uint32_t udpKbps = ETH_BENCH_UDP_KBPS);
+
+    /**
+     * @brief Stop a running benchmark; the partial result is kept
+     */
+    static void stopBenchmark();
+
+    /**
+     * @brief Wait for the benchmark task to finish
+     *
+     * @param timeoutMs Maximum time to wait
+     * @return true if no benchmark is running
+     */
+    static bool waitForBenchmark(uint32_t timeoutMs);
+
+    /**
+     * @brief Get the result of the running or last benchmark
+     *
+     * @return BenchmarkResult structure (live figures while running)
+     */
+    static BenchmarkResult getBenchmarkResult();
+
+    /**
+     * @brief Convert benchmark mode to string
+     *
+     * @param mode Mode to convert
+     * @return String representation of mode
+     */
+    static const char* benchmarkModeToString(EthBenchmarkMode mode);
+
+private:
+    friend struct MacFilterHooks;
+    friend struct TrafficShaperHooks;
+    friend struct BenchmarkRunner;
+    friend struct EthernetManagerTest;  // Unit tests reach the frame and timing helpers
+
+    /**
+     * @brief Private constructor for singleton pattern
+     */
+    EthernetManager();
+
+    /**
+     * @brief Destructor
+     */
+    ~EthernetManager();
+
+    /**
+     * @brief Event handler for Ethernet and IP events
+     */
     static void onEthEvent(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
 
+    /**
+     * @brief Event handler (un)registration on the default or private loop
+     */
+    esp_err_t registerEventHandlers();
+    void unregisterEventHandlers();
+    static void forwardEvent(void* arg, esp_event_base_t base, int32_t id, void* data);
+    static void dispatchForwardedEvent(void* arg, esp_event_base_t base, int32_t id, void* data);
+    static void eventProbeHandler(void* arg, esp_event_base_t base, int32_t id, void* data);
+
+    /**
+     * @brief Apply an EthernetConfig's feature settings ahead of driver install
+     */
+    static void applyConfig(const EthernetConfig& config);
+
     /**
      * @brief Internal initialization helper
      */
@@ -626,7 +2059,15 @@ private:
 
     // Event group for tracking Ethernet state
     EventGroupHandle_t ethEventGroup = nullptr;
-    static constexpr EventBits_t BIT_CONNECTED = BIT0;
+    static constexpr EventBits_t BIT_CONNECTED = BIT0;     // Ready per readyPolicy
+    static constexpr EventBits_t BIT_GOT_IP4 = BIT1;
+    static constexpr EventBits_t BIT_GOT_IP6 = BIT2;       // Routable IPv6 address
+    static constexpr EventBits_t BIT_READY_MASK = BIT_CONNECTED | BIT_GOT_IP4 | BIT_GOT_IP6;
+    static constexpr EventBits_t BIT_EVENT_PROBE = BIT3;   // measureEventDispatch() reply
+    static constexpr EventBits_t BIT_WOL_WAKE = BIT4;      // Magic packet matched while suspended
+    static constexpr EventBits_t BIT_BENCH_DONE = BIT5;    // Benchmark task finished
+    static constexpr EventBits_t BIT_RECOVERY_DONE = BIT6; // Recovery task finished
+    static constexpr EventBits_t BIT_FALLBACK_DONE = BIT7; // DHCP fallback task finished
 
     // Connection state tracking
     unsigned long lastGotIpTime = 0;
@@ -635,6 +2076,79 @@ private:
     bool phyStarted = false;
     bool eventHandlersRegistered = false;
 
+    // Private event loop
+    bool privateLoopEnabled = ETH_PRIVATE_EVENT_LOOP;
+    UBaseType_t privateLoopPriority = ETH_EVENT_LOOP_TASK_PRIORITY;
+    BaseType_t privateLoopCore = ETH_EVENT_LOOP_CORE;
+    uint16_t privateLoopQueue = ETH_EVENT_LOOP_QUEUE_SIZE;
+    esp_event_loop_handle_t privateLoop = nullptr;
+    esp_event_loop_handle_t registeredLoop = nullptr;  // Loop holding the handlers (nullptr = default)
+    EventLoopStats eventLoopStats = {};
+    uint64_t dispatchTotalUs = 0;
+    uint32_t dispatchCount = 0;
+    uint32_t probeLatencyUs = 0;
+
+    // DHCP fallback chain
+    bool staticIpMode = false;
+    EthAddressSource addressSource = EthAddressSource::NONE;
+    uint32_t dhcpFallbackTimeout = 0;
+    uint32_t dhcpRetryInterval = ETH_DHCP_RETRY_INTERVAL_MS;
+    bool fallbackAutoIp = true;
+    bool fallbackActive = false;
+    uint32_t fallbackIp = 0;
+    uint32_t fallbackGateway = 0;
+    uint32_t fallbackNetmask = 0;
+    uint32_t fallbackDns = 0;
+    uint32_t fallbackAppliedIp = 0;
+    uint32_t fallbackAppliedNetmask = 0;
+    uint32_t fallbackAppliedGateway = 0;
+    EthAddressSource fallbackAppliedSource = EthAddressSource::NONE;
+    TimerHandle_t dhcpFallbackTimer = nullptr;
+    TaskHandle_t fallbackTask = nullptr;
+
+    // Layer-3 health monitor
+    bool healthEnabled = false;
+    EthHealth health = EthHealth::UNKNOWN;
+    uint32_t healthTarget = 0;
+    uint32_t healthIntervalMs = ETH_HEALTH_INTERVAL_MS;
+    uint32_t healthFastIntervalMs = ETH_HEALTH_FAST_INTERVAL_MS;
+    uint32_t healthCurrentIntervalMs = ETH_HEALTH_FAST_INTERVAL_MS;
+    uint8_t healthGoodRounds = 0;
+    uint32_t healthWindow[2] = {0};   // Loss history bits per destination
+    uint64_t healthRttTotalUs[2] = {0};
+    uint32_t healthRttCount[2] = {0};
+    uint32_t degradedSince = 0;
+    uint16_t healthSeq = 0;
+    HealthStats healthStats = {};
+    TaskHandle_t healthTask = nullptr;
+
+    // ARP prewarm on GOT_IP (target 0 is the gateway when enabled)
+    static constexpr uint8_t ARP_MAX_TARGETS = ETH_MAX_ARP_PEERS + 1;
+    static_assert(ARP_MAX_TARGETS <= 32, "ARP pending mask is 32 bits");
+    bool garpEnabled = ETH_ENABLE_ARP_PREWARM;
+    bool arpResolveGateway = ETH_ENABLE_ARP_PREWARM;
+    uint32_t arpPeers[ETH_MAX_ARP_PEERS] = {0};
+    uint8_t arpPeerCount = 0;
+    uint32_t arpTargets[ARP_MAX_TARGETS] = {0};
+    uint8_t arpTargetCount = 0;
+    uint32_t arpPendingMask = 0;
+    uint8_t garpSent = 0;
+    int64_t arpPrewarmStartUs = 0;
+    int64_t arpLastSendUs = 0;
+    TimerHandle_t arpPrewarmTimer = nullptr;
+    uint32_t arpResolveLastUs = 0;
+    uint32_t arpResolveMaxUs = 0;
+    uint64_t arpResolveTotalUs = 0;
+    uint32_t arpResolveCount = 0;
+    uint32_t arpResolveFailures = 0;
+    uint32_t gratuitousArpsSent = 0;
+
+    // IPv6 tracking (slot = lwIP address index)
+    bool ipv6Enabled = false;
+    EthIpReadyPolicy readyPolicy = EthIpReadyPolicy::IPV4;
+    esp_ip6_addr_t ip6Addrs[ETH_MAX_IPV6_ADDRESSES] = {};
+    bool ip6Valid[ETH_MAX_IPV6_ADDRESSES] = {false};
+
     // Custom MAC storage
     uint8_t customMacAddress[ETH_MAC_ADDRESS_SIZE] = {0};
     bool hasCustomMac = false;
@@ -658,6 +2172,7 @@ private:
     EthDisconnectedCallback disconnectedCallback = nullptr;
     EthStateChangeCallback stateChangeCallback = nullptr;
     EthLinkStatusCallback linkStatusCallback = nullptr;
+    EthHealthCallback healthCallback = nullptr;
 
     // Auto-reconnect settings
     bool autoReconnectEnabled = false;
@@ -667,6 +2182,25 @@ private:
     uint32_t reconnectMaxDelay = 30000;
     uint32_t reconnectCurrentDelay = 1000;
     TimerHandle_t reconnectTimer = nullptr;
+    EthBackoffPolicy backoffPolicy = EthBackoffPolicy::EXPONENTIAL;
+    EthBackoffFunction backoffFunction = nullptr;
+    uint32_t backoffRng = 0;
+    EthRecoveryAction lastRecoveryAction = EthRecoveryAction::NONE;
+    EthRecoveryAction pendingRecovery = EthRecoveryAction::NONE;
+    TaskHandle_t recoveryTask = nullptr;
+    uint32_t dhcpWatchdogTimeout = ETH_DHCP_WATCHDOG_MS;
+    uint8_t dhcpWatchdogLevel = 0;
+    TimerHandle_t dhcpWatchdogTimer = nullptr;
+
+    // Backend start parameters kept for driver/netif recreation
+    char beginHostname[ETH_MAX_HOSTNAME_LENGTH + 1] = {0};
+    int8_t beginPhyAddr = ETH_PHY_ADDR;
+    int8_t beginMdcPin = ETH_PHY_MDC_PIN;
+    int8_t beginMdioPin = ETH_PHY_MDIO_PIN;
+    int8_t beginPowerPin = ETH_PHY_POWER_PIN;
+    eth_clock_mode_t beginClockMode = ETH_CLOCK_MODE;
+    IPAddress staticIp, staticGateway, staticSubnet, staticDns1, staticDns2;
+    esp_eth_handle_t ethHandle = nullptr;
 
     // Connection state machine
     EthConnectionState connectionState = EthConnectionState::UNINITIALIZED;
@@ -678,10 +2212,192 @@ private:
     TimerHandle_t linkMonitorTimer = nullptr;
     bool lastLinkStatus = false;
 
+    // Short blip hold (LINK_DOWN_HOLDING)
+    uint32_t linkHoldGraceMs = ETH_LINK_HOLD_GRACE_MS;
+    uint32_t holdStartMs = 0;
+    bool holdRestorePending = false;   // Restore heldLease on the netif at link up
+    bool holdConfirmPending = false;   // Next GOT_IP for heldLease.ip is the DHCP confirmation
+    BlipStats blipStats = {};
+    TimerHandle_t holdGraceTimer = nullptr;
+
+    // MDIO PHY discovery
+    EthPhyInfo phyInfo = {-1, 0, 0, "unknown", 0, false, 0};
+
+    // Warm restart
+    bool warmStartEnabled = false;     // Set through setWarmStart() (shutdown handler)
+    bool warmBoot = false;             // This boot kept the PHY's negotiated link
+    bool keepPhyState = false;         // Next backend start skips power toggle and PHY reset
+    uint32_t bootToLinkMs = 0;
+    uint32_t warmBaselineMs = 0;       // Cold boot-to-link carried across warm restarts
+
+    // PHY power management
+    bool eeeEnabled = ETH_PHY_EEE;
+    bool energyDetectEnabled = ETH_PHY_ENERGY_DETECT;
+    bool phyPowerPolicyApplied = false;  // PHY registers were written; disabling writes them back
+    bool phyLowPower = false;
+    EthPowerStats powerStats = {};     // Time-in-state totals and last probe results
+    uint32_t powerStateSince = 0;
+    bool powerAccounting = false;      // Time-in-state runs from the first driver start
+
+    // Wake-on-LAN suspend
+    bool wolEnabled = false;
+    int8_t wolWakePin = ETH_WOL_WAKE_PIN;
+    volatile bool wolArmed = false;    // Receive filter drops everything but magic packets
+    volatile bool wolMatched = false;
+    uint8_t wolMac[6] = {0};
+    uint32_t suspendedSince = 0;
+    WakeOnLanStats wolStats = {};      // Under ethMutex
+    volatile uint32_t wolFramesDropped = 0;  // Receive task only; merged in getWakeOnLanStats()
+
+    // EMAC address filtering; the table is only touched in the tcpip thread
+    struct MacFilterEntry {
+        uint8_t mac[6];
+        uint8_t groupRefs;             // lwIP IGMP/MLD joins
+        uint8_t manualRefs;            // addMacFilter() calls
+    };
+    bool multicastFilterEnabled = ETH_HW_MULTICAST_FILTER;
+    bool broadcastDropEnabled = false;
+    bool promiscuousEnabled = false;
+    MacFilterEntry macFilters[ETH_MAX_MAC_FILTERS] = {};
+    uint8_t macFilterCount = 0;
+    uint8_t macFilterSpill = 0;        // Joins that did not fit the table
+    bool macFilterOverflow = false;    // Pass-all-multicast fallback in effect
+    MacFilterStats macFilterStats = {};
+
+    // Receive classifier; rules are read lock-free on the EMAC receive task
+    struct RxRule {
+        EthRxMatch match;
+        uint16_t etherType;
+        uint32_t ratePps;              // 0 drops every match
+        uint32_t burstMilli;           // Bucket depth in 1/1000 tokens
+        uint32_t tokensMilli;
+        int64_t refilledUs;
+    };
+    volatile bool rxClassifierEnabled = false;
+    RxRule rxRules[ETH_MAX_RX_RULES] = {};
+    volatile uint8_t rxRuleCount = 0;
+
+    // Traffic shaper; egress queues and buckets are owned by the lwIP core,
+    // ingress buckets by the EMAC receive task
+    static constexpr uint8_t TRAFFIC_CLASSES = 4;
+    struct ShaperBucket {
+        uint32_t bytesPerSec;          // 0 = unlimited
+        uint32_t burst;
+        uint32_t tokens;
+        int64_t refilledUs;
+    };
+    struct ShaperQueueEntry {
+        struct pbuf* p;
+        int64_t enqueuedUs;
+    };
+    struct ShaperClass {
+        ShaperBucket egress;
+        ShaperBucket ingress;
+        ShaperQueueEntry queue[ETH_SHAPER_QUEUE_DEPTH];
+        uint8_t head;
+        uint8_t count;
+        uint64_t delayTotalUs;
+        TrafficClassStats stats;
+    };
+    struct ShaperRule {
+        EthTrafficMatch match;
+        uint16_t value;
+        EthTrafficClass cls;
+    };
+    volatile bool shaperEnabled = false;
+    ShaperClass shaperClasses[TRAFFIC_CLASSES] = {};
+    ShaperBucket shaperLink = {};
+    ShaperRule shaperRules[ETH_MAX_TRAFFIC_RULES] = {};
+    volatile uint8_t shaperRuleCount = 0;
+
+    // 802.1Q VLANs; tagging runs in the lwIP core (the shaper's linkoutput hook
+    // for the Ethernet interface), untagging on the receive task
+    struct VlanInterface {
+        esp_netif_driver_base_t base;  // First: esp_netif hands it back as the driver handle
+        uint16_t vid;
+        esp_netif_t* netif;
+        VlanStats stats;
+    };
+    volatile uint16_t vlanId = 0;      // Tag of the Ethernet interface (0 = untagged)
+    VlanStats vlanStats = {};
+    VlanInterface vlanInterfaces[ETH_MAX_VLANS] = {};
+    volatile uint8_t vlanInterfaceCount = 0;
+    uint8_t vlanPcp[TRAFFIC_CLASSES] = {6, 4, 0, 1};
+
+    // Throughput benchmark; the task owns the sockets, results go through the mutex
+    TaskHandle_t benchTask = nullptr;
+    volatile bool benchStop = false;
+    uint32_t benchPeer = 0;
+    uint16_t benchPort = ETH_BENCH_PORT;
+    uint32_t benchDurationMs = 0;
+    uint32_t benchUdpKbps = 0;
+    BenchmarkResult benchResult = {};
+
+    // Static-IP fast path
+    bool staticFastPathEnabled = ETH_STATIC_FAST_PATH;
+    bool staticFastPathPending = false;  // CONNECTED reported, GOT_IP not yet seen
+    int64_t staticFastPathUs = 0;
+    uint32_t staticFastPathCount = 0;
+    uint32_t staticFastPathSavedUs = 0;
+    uint64_t staticFastPathSavedTotalUs = 0;
+
+    // TCP abort on confirmed disconnect
+    bool socketAbortEnabled = ETH_ABORT_SOCKETS_ON_DISCONNECT;
+    EthSocketAbortCallback socketAbortCallback = nullptr;
+
+    // Link flap damping
+    bool flapDampingEnabled = ETH_ENABLE_FLAP_DAMPING;
+    uint32_t flapHalfLifeMs = ETH_FLAP_HALF_LIFE_MS;
+    uint32_t flapSuppressThreshold = ETH_FLAP_SUPPRESS_THRESHOLD;
+    uint32_t flapReuseThreshold = ETH_FLAP_REUSE_THRESHOLD;
+    float flapPenalty = 0.0f;
+    uint32_t flapPenaltyUpdated = 0;
+    bool linkSuppressed = false;
+    uint32_t suppressedSince = 0;
+    FlapStats flapStats = {};
+    TimerHandle_t flapReuseTimer = nullptr;
+
     // Performance monitoring
     uint32_t initStartTime = 0;
     uint32_t linkUpTime = 0;
     uint32_t ipObtainedTime = 0;
+    uint32_t bootToIpMs = 0;
+    uint32_t lastLinkToIpMs = 0;
+    uint32_t linkToIpCachedTotalMs = 0;
+    uint32_t linkToIpCachedCount = 0;
+    uint32_t linkToIpUncachedTotalMs = 0;
+    uint32_t linkToIpUncachedCount = 0;
+    uint32_t leaseCacheMisses = 0;
+
+    // DHCP lease cache (persisted in NVS)
+    struct DhcpLease {
+        uint32_t ip;
+        uint32_t netmask;
+        uint32_t gateway;
+        uint32_t server;
+        uint32_t leaseTimeS;
+        uint32_t obtainedEpoch;      // 0 if wall clock was not set
+    };
+    struct LeaseRecord {             // NVS layout of the lease cache
+        uint32_t version;
+        DhcpLease lease;
+    };
+    DhcpLease heldLease = {};         // Last IPv4 binding, restored after a blip
+    bool leaseCacheEnabled = false;
+    bool leaseLoaded = false;
+    volatile bool leaseRebooted = false;  // lwIP sent INIT-REBOOT at this link up
+    uint32_t leaseRebootIp = 0;           // Address it requested
+    uint8_t leaseSeedPolls = 0;
+    DhcpLease cachedLease = {};
+    TimerHandle_t leaseSeedTimer = nullptr;
+
+    // Deep-sleep snapshot (RTC memory)
+    struct SleepSnapshot;
+    static SleepSnapshot sleepSnapshot;
+    bool sleepResumed = false;
+    bool sleepLeasePending = false;    // Seed the snapshot lease at the next link up
+    bool sleepLeaseTrusted = false;    // Inside T1: put it on the netif before the ACK
+    uint32_t sleepBaselineMs = 0;      // Wake-to-IP without a snapshot, carried across sleeps
 
     // Debug logging
     void (*debugLogCallback)(const char*) = nullptr;
@@ -698,12 +2414,128 @@ private:
     QueueHandle_t eventQueue = nullptr;
     TimerHandle_t eventBatchTimer = nullptr;
 
+    // WiFi failover
+    bool failoverEnabled = false;
+    bool failoverPending = false;
+    char failoverSsid[33] = {0};
+    char failoverPassword[65] = {0};
+    EthFailoverMode failoverMode = EthFailoverMode::PRE_ASSOCIATED;
+    uint32_t failoverReturnStableMs = ETH_FAILOVER_RETURN_STABLE_MS;
+    EthUplink activeUplink = EthUplink::NONE;
+    int64_t failoverStartUs = 0;
+    uint32_t wifiUplinkSince = 0;
+    FailoverStats failoverStats = {0};
+    TimerHandle_t failbackTimer = nullptr;
+
     // Helper methods
     void updateStatistics();
     static void attemptReconnect(TimerHandle_t xTimer);
+    bool beginLinkHold();
+    void restoreLinkHold();
+    void resumeFromHold();
+    bool consumeHeldAddress(uint32_t ip);
+    EthBackendConfig backendConfig() const;
+    bool isEthernetNetif(esp_netif_t* netif);
+    void handleLostIp();
+    bool applyStaticFastPath();
+    void prepareWarmBoot();
+    static void warmShutdownHandler();
+    void applyPhyPowerPolicy();
+    void accountPowerState(bool linkUp);
+    bool resumeFromSuspend(bool magic);
+    static void resumeFromSuspendDeferred(void* param1, uint32_t param2);
+    void countWolSleep(bool spurious);
+    void wolFilterFrame(uint8_t* buffer, uint32_t length);
+    static bool isMagicPacket(const uint8_t* frame, uint32_t length, const uint8_t* mac);
+    bool installStackInput();
+    void removeStackInput();
+    static esp_err_t stackInput(esp_eth_handle_t handle, uint8_t* buffer, uint32_t length, void* priv);
+    bool macFilterActive() const;
+    bool receiveHookNeeded() const;
+    void restoreReceivePath();
+    bool shedFrame(const uint8_t* frame, uint32_t length, esp_netif_t* netif);
+    EthTrafficClass classifyTraffic(const uint8_t* frame, uint32_t length);
+    bool policeIngress(const uint8_t* frame, uint32_t length);
+    bool egressHookNeeded() const;
+    void attachEgressHook();
+    void detachEgressHook();
+    bool vlanActive() const;
+    esp_netif_t* vlanInput(uint8_t* buffer, uint32_t& length, esp_netif_t* netif);
+    esp_err_t transmitTagged(uint16_t vid, const uint8_t* frame, size_t length, VlanStats& counters);
+    struct pbuf* vlanTag(struct pbuf* p);
+    void forwardVlanEvent(int32_t id);
+    void destroyVlanInterfaces();
+    static esp_err_t vlanInterfaceTransmit(void* handle, void* buffer, size_t length);
+    static esp_err_t vlanInterfaceTransmitWrap(void* handle, void* buffer, size_t length, void* netstackBuffer);
+    static esp_err_t vlanPostAttach(esp_netif_t* netif, void* handle);
+    static void vlanFreeRxBuffer(void* handle, void* buffer);
+    void programMacFilters();
+    bool addFilterEntry(const uint8_t* mac, bool manual);
+    bool removeFilterEntry(const uint8_t* mac, bool manual);
+    bool consumeStaticGotIp(uint32_t ip);
+    void confirmDisconnect();
+    uint32_t abortConnections();
+    static void holdGraceTimerCallback(TimerHandle_t xTimer);
+    static void resumeFromHoldDeferred(void* param1, uint32_t param2);
+    void recordFlap();
+    float decayFlapPenalty();
+    static void flapReuseTimerCallback(TimerHandle_t xTimer);
+    void scheduleReconnect();
+    uint32_t nextBackoffDelay();
+    uint32_t backoffRandom(uint32_t lo, uint32_t hi);
+    EthRecoveryAction nextRecoveryAction();
+    EthRecoveryAction recoveryActionForStep(size_t step);
+    void startRecovery(EthRecoveryAction action);
+    void handleDhcpWatchdogStateChange(EthConnectionState newState);
+    static void dhcpWatchdogCallback(TimerHandle_t xTimer);
+    bool runRecoveryAction(EthRecoveryAction action);
+    bool recreateInterface();
+    void stopRecovery();
+    void drivePhyPower(bool on);
+    static void recoveryTaskFunc(void* param);
     static void linkMonitorTask(TimerHandle_t xTimer);
     void changeState(EthConnectionState newState);
     bool updateLinkStatus();
     static void processBatchedEvents(TimerHandle_t xTimer);
     void queueEvent(esp_event_base_t base, int32_t id, void* data);
+    void armDhcpFallback();
+    bool applyFallbackAddress();
+    bool applyIPv4(uint32_t ip, uint32_t netmask, uint32_t gw, uint32_t dns, EthAddressSource source);
+    bool retryDhcp();
+    static uint32_t nextAutoIpCandidate(uint32_t& seed);
+    void stopFallback();
+    bool arpProbeConflict(uint32_t ip);
+    bool icmpProbe(int sock, uint32_t dst, uint32_t& rttUs);
+    void recordProbe(uint8_t slot, bool ok, uint32_t rttUs);
+    void setHealth(EthHealth newHealth);
+    void handleHealthStateChange(EthConnectionState newState);
+    static void healthTaskFunc(void* param);
+    void startArpPrewarm(uint32_t ip, uint32_t netmask, uint32_t gateway);
+    void sendArpPrewarm(bool announce);
+    static void arpPrewarmTimerCallback(TimerHandle_t xTimer);
+    static void dhcpFallbackTimerCallback(TimerHandle_t xTimer);
+    static void fallbackTaskFunc(void* param);
+    bool loadLease();
+    void saveLease(const DhcpLease& lease);
+    bool captureLease(DhcpLease& lease);
+    void persistLease();
+    bool leaseWithinRenewal(const DhcpLease& lease) const;
+    static const char* identifyPhy(uint16_t id1, uint16_t id2);
+    bool restoreSleepSnapshot(EthernetConfig& config);
+    void resumeSleepLease();
+    static void resumeSleepLeaseDeferred(void* param1, uint32_t param2);
+    void startLeaseSeed();
+    void handleDhcpLease(uint32_t ip);
+    bool createLeaseSeedTimer();
+    static void leaseSeedTimerCallback(TimerHandle_t xTimer);
+    static void seedLeaseInTcpip(void* ctx);
+    void restoreLeaseOnNetif(struct netif* nif, const DhcpLease& lease);
+    bool readinessSatisfied() const;
+    void evaluateReadiness(bool reannounce);
+    void clearAddresses();
+    void handleFailoverStateChange(EthConnectionState newState);
+    void handleFailoverIpEvent(int32_t id);
+    void switchToWiFi();
+    void switchToEthernet();
+    static void failbackTimerCallback(TimerHandle_t xTimer);
 };
@@ -0,0 +1,252 @@
+// EthernetManagerArp.cpp
+// ARP helpers: address conflict probing, gratuitous ARP and gateway prewarm
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_netif.h>
+#include <esp_timer.h>
+
+#include <lwip/etharp.h>
+#include <lwip/netif.h>
+#include <lwip/tcpip.h>
+
+namespace {
+
+// Synchronous call into the tcpip thread (lwIP ARP table is not thread-safe)
+struct ArpCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    ip4_addr_t addr;
+    bool found;
+};
+
+err_t arpQueryInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<ArpCall*>(call);
+    return etharp_query(msg->nif, &msg->addr, nullptr);
+}
+
+err_t arpFindInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<ArpCall*>(call);
+    struct eth_addr* ethRet = nullptr;
+    const ip4_addr_t* ipRet = nullptr;
+    msg->found = etharp_find_addr(msg->nif, &msg->addr, &ethRet, &ipRet) >= 0;
+    return ERR_OK;
+}
+
+// Prewarm batch: query / check several targets in one tcpip round trip
+struct ArpBatchCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    const uint32_t* targets;
+    uint8_t count;
+    uint32_t mask;
+    bool announce;
+    uint32_t resolved;
+};
+
+err_t arpSendBatchInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<ArpBatchCall*>(call);
+    if (msg->announce) {
+        etharp_gratuitous(msg->nif);
+    }
+    for (uint8_t i = 0; i < msg->count; i++) {
+        if (msg->mask & (1u << i)) {
+            ip4_addr_t addr;
+            ip4_addr_set_u32(&addr, msg->targets[i]);
+            etharp_query(msg->nif, &addr, nullptr);
+        }
+    }
+    return ERR_OK;
+}
+
+err_t arpCheckBatchInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<ArpBatchCall*>(call);
+    msg->resolved = 0;
+    for (uint8_t i = 0; i < msg->count; i++) {
+        if (!(msg->mask & (1u << i))) continue;
+        ip4_addr_t addr;
+        ip4_addr_set_u32(&addr, msg->targets[i]);
+        struct eth_addr* ethRet = nullptr;
+        const ip4_addr_t* ipRet = nullptr;
+        if (etharp_find_addr(msg->nif, &addr, &ethRet, &ipRet) >= 0) {
+            msg->resolved |= 1u << i;
+        }
+    }
+    return ERR_OK;
+}
+
+}  // namespace
+
+bool EthernetManager::arpProbeConflict(uint32_t ip) {
+    if (!eth_netif) return false;
+
+    ArpCall msg = {};
+    msg.nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (!msg.nif) return false;
+    ip4_addr_set_u32(&msg.addr, ip);
+
+    // etharp sends from the netif address; an RFC 5227 probe needs sender
+    // 0.0.0.0, so a fallback address held from an earlier round is dropped
+    // until this candidate is confirmed free
+    esp_netif_ip_info_t current = {};
+    if (esp_netif_get_ip_info(eth_netif, &current) == ESP_OK && current.ip.addr != 0) {
+        esp_netif_ip_info_t none = {};
+        esp_netif_set_ip_info(eth_netif, &none);
+    }
+
+    // Any reply turns the pending entry stable and marks the address as taken
+    for (uint8_t i = 0; i < ETH_ARP_PROBE_COUNT; i++) {
+        tcpip_api_call(arpQueryInTcpip, &msg.call);
+        vTaskDelay(pdMS_TO_TICKS(ETH_ARP_PROBE_WAIT_MS));
+
+        tcpip_api_call(arpFindInTcpip, &msg.call);
+        if (msg.found) {
+            ETH_LOG_W("Address conflict: " IPSTR " answered ARP probe", IP2STR((esp_ip4_addr_t*)&ip));
+            MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+            if (guard) {
+                stats.addressConflicts++;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void EthernetManager::setArpPrewarm(bool gratuitousArp, bool resolveGateway) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.garpEnabled = gratuitousArp;
+        inst.arpResolveGateway = resolveGateway;
+    }
+}
+
+bool EthernetManager::addArpPeer(IPAddress peer) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        return false;
+    }
+
+    if (inst.arpPeerCount >= ETH_MAX_ARP_PEERS || (uint32_t)peer == 0) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+    inst.arpPeers[inst.arpPeerCount++] = (uint32_t)peer;
+    return true;
+}
+
+void EthernetManager::clearArpPeers() {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.arpPeerCount = 0;
+    }
+}
+
+void EthernetManager::startArpPrewarm(uint32_t ip, uint32_t netmask, uint32_t gateway) {
+    if (!eth_netif || ip == 0) return;
+
+    if (arpPrewarmTimer) {
+        xTimerStop(arpPrewarmTimer, 0);
+    }
+
+    arpTargetCount = 0;
+    if (arpResolveGateway && gateway != 0) {
+        arpTargets[arpTargetCount++] = gateway;
+    }
+    for (uint8_t i = 0; i < arpPeerCount; i++) {
+        // Off-subnet peers are reached through the gateway, not ARP
+        if ((arpPeers[i] & netmask) == (ip & netmask) && arpPeers[i] != gateway) {
+            arpTargets[arpTargetCount++] = arpPeers[i];
+        }
+    }
+    arpPendingMask = arpTargetCount > 0 ? (uint32_t)((1ull << arpTargetCount) - 1) : 0;
+    garpSent = 0;
+
+    if (arpPendingMask == 0 && !garpEnabled) return;
+
+    if (!arpPrewarmTimer) {
+        TickType_t period = pdMS_TO_TICKS(ETH_ARP_POLL_MS) > 0 ? pdMS_TO_TICKS(ETH_ARP_POLL_MS) : 1;
+        arpPrewarmTimer = xTimerCreate("EthArpPrewarm", period, pdTRUE, nullptr, arpPrewarmTimerCallback);
+        if (!arpPrewarmTimer) {
+            ETH_LOG_E("Failed to create ARP prewarm timer");
+            return;
+        }
+    }
+
+    // Requests leave now; packets sent before the reply queue on the pending entry
+    arpPrewarmStartUs = esp_timer_get_time();
+    sendArpPrewarm(garpEnabled);
+    xTimerStart(arpPrewarmTimer, 0);
+}
+
+void EthernetManager::sendArpPrewarm(bool announce) {
+    ArpBatchCall msg = {};
+    msg.nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (!msg.nif) return;
+    msg.targets = arpTargets;
+    msg.count = arpTargetCount;
+    msg.mask = arpPendingMask;
+    msg.announce = announce;
+    tcpip_api_call(arpSendBatchInTcpip, &msg.call);
+
+    arpLastSendUs = esp_timer_get_time();
+    if (announce) {
+        garpSent++;
+        gratuitousArpsSent++;
+    }
+}
+
+void EthernetManager::arpPrewarmTimerCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+    struct netif* nif = inst.eth_netif ?
+        static_cast<struct netif*>(esp_netif_get_netif_impl(inst.eth_netif)) : nullptr;
+    if (!nif) {
+        xTimerStop(xTimer, 0);
+        return;
+    }
+
+    if (inst.arpPendingMask) {
+        ArpBatchCall msg = {};
+        msg.nif = nif;
+        msg.targets = inst.arpTargets;
+        msg.count = inst.arpTargetCount;
+        msg.mask = inst.arpPendingMask;
+        tcpip_api_call(arpCheckBatchInTcpip, &msg.call);
+
+        // Latency is from GOT_IP, at ETH_ARP_POLL_MS granularity
+        uint32_t elapsedUs = (uint32_t)(esp_timer_get_time() - inst.arpPrewarmStartUs);
+        for (uint8_t i = 0; i < inst.arpTargetCount; i++) {
+            if (!(msg.resolved & (1u << i))) continue;
+            inst.arpResolveLastUs = elapsedUs;
+            inst.arpResolveTotalUs += elapsedUs;
+            inst.arpResolveCount++;
+            if (elapsedUs > inst.arpResolveMaxUs) {
+                inst.arpResolveMaxUs = elapsedUs;
+            }
+            ETH_LOG_D("ARP resolved " IPSTR " in %u us", IP2STR((esp_ip4_addr_t*)&inst.arpTargets[i]), elapsedUs);
+        }
+        inst.arpPendingMask &= ~msg.resolved;
+    }
+
+    int64_t now = esp_timer_get_time();
+    bool announceDue = inst.garpEnabled && inst.garpSent < ETH_GARP_COUNT;
+
+    if (now - inst.arpPrewarmStartUs >= (int64_t)ETH_ARP_PREWARM_TIMEOUT_MS * 1000 && inst.arpPendingMask) {
+        uint32_t unresolved = __builtin_popcount(inst.arpPendingMask);
+        inst.arpResolveFailures += unresolved;
+        inst.arpPendingMask = 0;
+        ETH_LOG_W("ARP prewarm: %u target(s) did not answer", unresolved);
+    }
+
+    if (!inst.arpPendingMask && !announceDue) {
+        xTimerStop(xTimer, 0);
+        return;
+    }
+
+    // Repeat announcements and re-query silent targets
+    if (now - inst.arpLastSendUs >= (int64_t)ETH_GARP_INTERVAL_MS * 1000) {
+        inst.sendArpPrewarm(announceDue);
+    }
+}
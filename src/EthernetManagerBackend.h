@@ -0,0 +1,99 @@
+// EthernetManagerBackend.h
+// Compile-time Ethernet driver backends: Arduino ETH or native esp_eth
+#pragma once
+
+#include "EthernetManagerConfig.h"
+
+#include <esp_eth.h>
+#include <esp_netif.h>
+
+#if !ETH_BACKEND_NATIVE || __has_include(<ETH.h>)
+#include <ETH.h>
+#else
+// Same values as the Arduino core's eth_clock_mode_t
+typedef enum {
+    ETH_CLOCK_GPIO0_IN = 0,
+    ETH_CLOCK_GPIO0_OUT = 1,
+    ETH_CLOCK_GPIO16_OUT = 2,
+    ETH_CLOCK_GPIO17_OUT = 3
+} eth_clock_mode_t;
+#endif
+
+/**
+ * @brief Everything a backend needs to bring up the EMAC + LAN8720
+ */
+struct EthBackendConfig {
+    const char* hostname;
+    int8_t phyAddr;
+    int8_t mdcPin;
+    int8_t mdioPin;
+    int8_t powerPin;
+    eth_clock_mode_t clockMode;
+    const uint8_t* mac;          ///< nullptr keeps the factory MAC
+    bool keepPhyState;           ///< Warm start: no power-pin toggle or PHY reset
+    bool staticIp;
+    IPAddress ip;
+    IPAddress gateway;
+    IPAddress subnet;
+    IPAddress dns1;
+    IPAddress dns2;
+};
+
+/**
+ * @brief Backend over the Arduino ETH object (2.x and 3.x cores)
+ */
+class ArduinoEthBackend {
+public:
+    static constexpr const char* NAME = "Arduino ETH";
+
+    static bool begin(const EthBackendConfig& cfg);
+    static void end();
+    static bool canRecreate();
+    static esp_netif_t* netif();
+    static esp_eth_handle_t handle();   ///< nullptr when the core does not expose it (2.x)
+    static bool linkUp();
+    static IPAddress localIP();
+    static uint8_t linkSpeed();
+    static bool fullDuplex();
+    static String macAddress();
+    static const char* hostname();
+};
+
+/**
+ * @brief Backend driving esp_eth and esp_netif directly
+ *
+ * Installs the ESP32 EMAC and LAN87xx PHY drivers, attaches the netif glue
+ * and starts the driver without going through the Arduino ETH object.
+ */
+class NativeEthBackend {
+public:
+    static constexpr const char* NAME = "native esp_eth";
+
+    static bool begin(const EthBackendConfig& cfg);
+    static void end();
+    static bool canRecreate() { return true; }
+    static esp_netif_t* netif();
+    static esp_eth_handle_t handle();
+    static bool linkUp();
+    static IPAddress localIP();
+    static uint8_t linkSpeed();
+    static bool fullDuplex();
+    static String macAddress();
+    static const char* hostname();
+};
+
+// ESP32 EMAC for the configured SMI pins and RMII clock (not yet initialized)
+esp_eth_mac_t* ethNewEsp32Emac(const EthBackendConfig& cfg);
+
+// Drive the PHY power/oscillator enable pin high and let it settle
+void ethPowerOnPhy(int8_t powerPin);
+
+// Initialized EMAC for MDIO register access only, without a driver install
+esp_eth_mac_t* ethOpenSmi(const EthBackendConfig& cfg);
+void ethCloseSmi(esp_eth_mac_t* mac);
+
+#if ETH_BACKEND_NATIVE
+using EthBackend = NativeEthBackend;
+#else
+using EthBackend = ArduinoEthBackend;
+#endif
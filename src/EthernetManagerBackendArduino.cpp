@@ -0,0 +1,110 @@
+// EthernetManagerBackendArduino.cpp
+// Arduino ETH backend: ETH.begin/config with the 2.x / 3.x argument orders
+#include "EthernetManagerBackend.h"
+
+#if !ETH_BACKEND_NATIVE
+
+bool ArduinoEthBackend::begin(const EthBackendConfig& cfg) {
+    bool success;
+    bool configured = true;
+
+    // ETH.begin() pulses the power pin; on a warm start it is already high.
+    // The PHY's own soft reset inside ETH cannot be skipped from here.
+    int8_t powerPin = cfg.keepPhyState ? -1 : cfg.powerPin;
+
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    // Pre-configure hostname to avoid multiple sets
+    if (cfg.hostname) {
+        ETH.setHostname(cfg.hostname);
+    }
+
+    success = ETH.begin(ETH_PHY_LAN8720, cfg.phyAddr, cfg.mdcPin, cfg.mdioPin, powerPin, cfg.clockMode);
+    if (!success) return false;
+
+    if (cfg.staticIp) {
+        configured = cfg.mac ?
+            ETH.config(cfg.ip, cfg.gateway, cfg.subnet, cfg.dns1, cfg.dns2, cfg.mac) :
+            ETH.config(cfg.ip, cfg.gateway, cfg.subnet, cfg.dns1, cfg.dns2);
+    } else if (cfg.mac) {
+        configured = ETH.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, cfg.mac);
+    }
+#else
+    success = ETH.begin(powerPin, cfg.mdcPin, cfg.mdioPin, cfg.phyAddr, ETH_PHY_LAN8720, cfg.clockMode);
+    if (!success) return false;
+
+    if (cfg.hostname) {
+        ETH.setHostname(cfg.hostname);
+    }
+
+    // 2.x has no secondary DNS in config()
+    if (cfg.staticIp) {
+        configured = cfg.mac ?
+            ETH.config(cfg.ip, cfg.gateway, cfg.subnet, cfg.dns1, cfg.mac) :
+            ETH.config(cfg.ip, cfg.gateway, cfg.subnet, cfg.dns1);
+    } else if (cfg.mac) {
+        configured = ETH.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE, cfg.mac);
+    }
+#endif
+
+    if (!configured) {
+        if (cfg.staticIp) {
+            ETH_LOG_E("Failed to configure static IP");
+            return false;
+        }
+        ETH_LOG_W("Failed to set custom MAC address");  // Not critical
+    }
+    return true;
+}
+
+void ArduinoEthBackend::end() {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    ETH.end();
+#endif
+}
+
+bool ArduinoEthBackend::canRecreate() {
+    // Arduino 2.x cannot tear ETH down
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    return true;
+#else
+    return false;
+#endif
+}
+
+esp_netif_t* ArduinoEthBackend::netif() {
+    return esp_netif_get_handle_from_ifkey("ETH_DEF");
+}
+
+esp_eth_handle_t ArduinoEthBackend::handle() {
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    return ETH.handle();
+#else
+    return nullptr;  // 2.x keeps the handle private
+#endif
+}
+
+bool ArduinoEthBackend::linkUp() {
+    return ETH.linkUp();
+}
+
+IPAddress ArduinoEthBackend::localIP() {
+    return ETH.localIP();
+}
+
+uint8_t ArduinoEthBackend::linkSpeed() {
+    return ETH.linkSpeed();
+}
+
+bool ArduinoEthBackend::fullDuplex() {
+    return ETH.fullDuplex();
+}
+
+String ArduinoEthBackend::macAddress() {
+    return ETH.macAddress();
+}
+
+const char* ArduinoEthBackend::hostname() {
+    return ETH.getHostname();
+}
+
+#endif  // !ETH_BACKEND_NATIVE
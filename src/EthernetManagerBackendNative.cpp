@@ -0,0 +1,289 @@
+// EthernetManagerBackendNative.cpp
+// Native backend: esp_eth driver install, netif glue and start without Arduino ETH
+#include "EthernetManagerBackend.h"
+
+#include <driver/gpio.h>
+#include <esp_eth.h>
+#include <esp_event.h>
+#include <esp_idf_version.h>
+
+// EMAC construction and PHY power-up are shared with the MDIO PHY scan,
+// which runs ahead of either backend
+
+esp_eth_mac_t* ethNewEsp32Emac(const EthBackendConfig& cfg) {
+    eth_mac_config_t macConfig = ETH_MAC_DEFAULT_CONFIG();
+
+    // RMII reference clock: GPIO0 input from the PHY, or generated by the ESP32
+    emac_rmii_clock_mode_t clockMode = cfg.clockMode == ETH_CLOCK_GPIO0_IN ? EMAC_CLK_EXT_IN : EMAC_CLK_OUT;
+    emac_rmii_clock_gpio_t clockGpio =
+        cfg.clockMode == ETH_CLOCK_GPIO0_IN ? EMAC_CLK_IN_GPIO :
+        cfg.clockMode == ETH_CLOCK_GPIO0_OUT ? EMAC_APPL_CLK_OUT_GPIO :
+        cfg.clockMode == ETH_CLOCK_GPIO16_OUT ? EMAC_CLK_OUT_GPIO : EMAC_CLK_OUT_180_GPIO;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    eth_esp32_emac_config_t emacConfig = ETH_ESP32_EMAC_DEFAULT_CONFIG();
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+    emacConfig.smi_gpio.mdc_num = cfg.mdcPin;
+    emacConfig.smi_gpio.mdio_num = cfg.mdioPin;
+#else
+    emacConfig.smi_mdc_gpio_num = cfg.mdcPin;
+    emacConfig.smi_mdio_gpio_num = cfg.mdioPin;
+#endif
+    emacConfig.clock_config.rmii.clock_mode = clockMode;
+    emacConfig.clock_config.rmii.clock_gpio = clockGpio;
+    return esp_eth_mac_new_esp32(&emacConfig, &macConfig);
+#else
+    macConfig.smi_mdc_gpio_num = cfg.mdcPin;
+    macConfig.smi_mdio_gpio_num = cfg.mdioPin;
+    macConfig.clock_config.rmii.clock_mode = clockMode;
+    macConfig.clock_config.rmii.clock_gpio = clockGpio;
+    return esp_eth_mac_new_esp32(&macConfig);
+#endif
+}
+
+void ethPowerOnPhy(int8_t powerPin) {
+    if (powerPin < 0) return;
+    gpio_reset_pin((gpio_num_t)powerPin);
+    gpio_set_direction((gpio_num_t)powerPin, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)powerPin, 1);
+    vTaskDelay(pdMS_TO_TICKS(ETH_PHY_POWER_ON_SETTLE_MS));
+}
+
+#if ETH_BACKEND_NATIVE
+
+namespace {
+
+esp_eth_handle_t ethHandle = nullptr;
+esp_eth_mac_t* ethMac = nullptr;
+esp_eth_phy_t* ethPhy = nullptr;
+esp_eth_netif_glue_handle_t ethGlue = nullptr;
+esp_netif_t* ethNetif = nullptr;
+volatile bool ethLinkUp = false;
+
+void onLinkEvent(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    if (!data || *static_cast<esp_eth_handle_t*>(data) != ethHandle) return;
+    if (id == ETHERNET_EVENT_CONNECTED) {
+        ethLinkUp = true;
+    } else if (id == ETHERNET_EVENT_DISCONNECTED || id == ETHERNET_EVENT_STOP) {
+        ethLinkUp = false;
+    }
+}
+
+// Warm start: the PHY already holds a negotiated link from before esp_restart()
+esp_err_t keepPhyNoop(esp_eth_phy_t* phy) {
+    return ESP_OK;
+}
+
+esp_err_t keepPhyInit(esp_eth_phy_t* phy) {
+    return phy->pwrctl(phy, true);  // Clears power-down only, no BMCR reset
+}
+
+void keepPhyState(esp_eth_phy_t* phy) {
+    phy->init = keepPhyInit;
+    phy->reset = keepPhyNoop;
+    phy->reset_hw = keepPhyNoop;
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    phy->negotiate = keepPhyNoop;   // 4.x restarts autonegotiation in esp_eth_start()
+#endif
+}
+
+void applyStaticIp(const EthBackendConfig& cfg) {
+    esp_netif_dhcpc_stop(ethNetif);
+
+    esp_netif_ip_info_t info = {};
+    info.ip.addr = (uint32_t)cfg.ip;
+    info.gw.addr = (uint32_t)cfg.gateway;
+    info.netmask.addr = (uint32_t)cfg.subnet;
+    esp_netif_set_ip_info(ethNetif, &info);
+
+    esp_netif_dns_info_t dns = {};
+    dns.ip.type = ESP_IPADDR_TYPE_V4;
+    if ((uint32_t)cfg.dns1 != 0) {
+        dns.ip.u_addr.ip4.addr = (uint32_t)cfg.dns1;
+        esp_netif_set_dns_info(ethNetif, ESP_NETIF_DNS_MAIN, &dns);
+    }
+    if ((uint32_t)cfg.dns2 != 0) {
+        dns.ip.u_addr.ip4.addr = (uint32_t)cfg.dns2;
+        esp_netif_set_dns_info(ethNetif, ESP_NETIF_DNS_BACKUP, &dns);
+    }
+}
+
+}  // namespace
+
+bool NativeEthBackend::begin(const EthBackendConfig& cfg) {
+    if (ethHandle) {
+        ETH_LOG_W("Native Ethernet already started");
+        return true;
+    }
+
+    esp_err_t err = esp_netif_init();
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ETH_LOG_E("esp_netif_init failed: %d", err);
+        return false;
+    }
+
+    // Power/oscillator enable for boards that gate the PHY
+    if (!cfg.keepPhyState) {
+        ethPowerOnPhy(cfg.powerPin);
+    }
+
+    esp_netif_config_t netifConfig = ESP_NETIF_DEFAULT_ETH();
+    ethNetif = esp_netif_new(&netifConfig);
+    if (!ethNetif) {
+        ETH_LOG_E("Failed to create Ethernet netif");
+        return false;
+    }
+    if (cfg.hostname) {
+        esp_netif_set_hostname(ethNetif, cfg.hostname);
+    }
+
+    // Address is in place before the driver starts, so link up needs no DHCP
+    if (cfg.staticIp) {
+        applyStaticIp(cfg);
+    }
+
+    eth_phy_config_t phyConfig = ETH_PHY_DEFAULT_CONFIG();
+    phyConfig.phy_addr = cfg.phyAddr;
+    phyConfig.reset_gpio_num = -1;  // Power pin handled above
+
+    ethMac = ethNewEsp32Emac(cfg);
+    ethPhy = esp_eth_phy_new_lan87xx(&phyConfig);
+    if (!ethMac || !ethPhy) {
+        ETH_LOG_E("Failed to create EMAC/PHY driver");
+        end();
+        return false;
+    }
+
+    if (cfg.keepPhyState) {
+        keepPhyState(ethPhy);
+    }
+
+    esp_eth_config_t ethConfig = ETH_DEFAULT_CONFIG(ethMac, ethPhy);
+    if (cfg.keepPhyState) {
+        // The link is already up; don't wait a full default poll period to see it
+        ethConfig.check_link_period_ms = ETH_WARM_START_LINK_POLL_MS;
+    }
+    err = esp_eth_driver_install(&ethConfig, &ethHandle);
+    if (err != ESP_OK) {
+        ETH_LOG_E("esp_eth_driver_install failed: %d", err);
+        ethHandle = nullptr;
+        end();
+        return false;
+    }
+
+    if (cfg.mac && esp_eth_ioctl(ethHandle, ETH_CMD_S_MAC_ADDR, (void*)cfg.mac) != ESP_OK) {
+        ETH_LOG_W("Failed to set custom MAC address");  // Not critical
+    }
+
+    ethGlue = esp_eth_new_netif_glue(ethHandle);
+    err = ethGlue ? esp_netif_attach(ethNetif, ethGlue) : ESP_FAIL;
+    if (err != ESP_OK) {
+        ETH_LOG_E("esp_netif_attach failed: %d", err);
+        end();
+        return false;
+    }
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    // IDF 4.x glue needs the netif action handlers registered explicitly
+    esp_eth_set_default_handlers(ethNetif);
+#endif
+
+    esp_event_handler_register(ETH_EVENT, ESP_EVENT_ANY_ID, onLinkEvent, nullptr);
+
+    err = esp_eth_start(ethHandle);
+    if (err != ESP_OK) {
+        ETH_LOG_E("esp_eth_start failed: %d", err);
+        end();
+        return false;
+    }
+    return true;
+}
+
+void NativeEthBackend::end() {
+    esp_event_handler_unregister(ETH_EVENT, ESP_EVENT_ANY_ID, onLinkEvent);
+    ethLinkUp = false;
+
+    if (ethHandle) {
+        esp_eth_stop(ethHandle);
+    }
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    if (ethNetif) {
+        esp_eth_clear_default_handlers(ethNetif);
+    }
+#endif
+    if (ethGlue) {
+        esp_eth_del_netif_glue(ethGlue);
+        ethGlue = nullptr;
+    }
+    if (ethHandle) {
+        esp_eth_driver_uninstall(ethHandle);
+        ethHandle = nullptr;
+    }
+    if (ethPhy) {
+        ethPhy->del(ethPhy);
+        ethPhy = nullptr;
+    }
+    if (ethMac) {
+        ethMac->del(ethMac);
+        ethMac = nullptr;
+    }
+    if (ethNetif) {
+        esp_netif_destroy(ethNetif);
+        ethNetif = nullptr;
+    }
+}
+
+esp_netif_t* NativeEthBackend::netif() {
+    return ethNetif;
+}
+
+esp_eth_handle_t NativeEthBackend::handle() {
+    return ethHandle;
+}
+
+bool NativeEthBackend::linkUp() {
+    return ethLinkUp;
+}
+
+IPAddress NativeEthBackend::localIP() {
+    esp_netif_ip_info_t info = {};
+    if (!ethNetif || esp_netif_get_ip_info(ethNetif, &info) != ESP_OK) {
+        return IPAddress();
+    }
+    return IPAddress(info.ip.addr);
+}
+
+uint8_t NativeEthBackend::linkSpeed() {
+    eth_speed_t speed = ETH_SPEED_10M;
+    if (ethHandle) {
+        esp_eth_ioctl(ethHandle, ETH_CMD_G_SPEED, &speed);
+    }
+    return speed == ETH_SPEED_100M ? 100 : 10;
+}
+
+bool NativeEthBackend::fullDuplex() {
+    eth_duplex_t duplex = ETH_DUPLEX_HALF;
+    if (ethHandle) {
+        esp_eth_ioctl(ethHandle, ETH_CMD_G_DUPLEX_MODE, &duplex);
+    }
+    return duplex == ETH_DUPLEX_FULL;
+}
+
+String NativeEthBackend::macAddress() {
+    uint8_t mac[6] = {0};
+    if (ethHandle) {
+        esp_eth_ioctl(ethHandle, ETH_CMD_G_MAC_ADDR, mac);
+    }
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    return String(buf);
+}
+
+const char* NativeEthBackend::hostname() {
+    const char* name = nullptr;
+    if (ethNetif) {
+        esp_netif_get_hostname(ethNetif, &name);
+    }
+    return name;
+}
+
+#endif  // ETH_BACKEND_NATIVE
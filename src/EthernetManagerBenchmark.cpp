@@ -0,0 +1,512 @@
+// EthernetManagerBenchmark.cpp
+// iperf-style throughput benchmark: TCP/UDP client and server on the Ethernet
+// netif, with UDP loss and jitter and per-core CPU load over the run
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_idf_version.h>
+#include <esp_netif.h>
+#include <esp_timer.h>
+
+#include <lwip/sockets.h>
+
+static constexpr uint32_t SOCKET_POLL_MS = 100;       // Socket timeout between stop checks
+static constexpr uint32_t UDP_HEADER_LEN = 12;        // iperf 2 datagram: id, seconds, microseconds
+static constexpr uint8_t UDP_FIN_REPEATS = 10;
+static constexpr uint8_t CPU_UNAVAILABLE = 255;
+static constexpr uint8_t BENCH_CORES = portNUM_PROCESSORS < 2 ? portNUM_PROCESSORS : 2;
+
+static_assert(ETH_BENCH_UDP_PAYLOAD >= UDP_HEADER_LEN && ETH_BENCH_UDP_PAYLOAD <= ETH_BENCH_BUFFER_SIZE,
+              "ETH_BENCH_UDP_PAYLOAD must be 12..ETH_BENCH_BUFFER_SIZE");
+
+namespace {
+
+bool retryable(int err) {
+    return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+// Run time of each core's idle task. Needs FreeRTOS run-time stats on the
+// esp_timer clock (the IDF default), so the counters are in microseconds.
+bool sampleIdle(uint32_t idle[BENCH_CORES]) {
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    UBaseType_t capacity = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t* tasks = static_cast<TaskStatus_t*>(malloc(capacity * sizeof(TaskStatus_t)));
+    if (!tasks) return false;
+
+    UBaseType_t count = uxTaskGetSystemState(tasks, capacity, nullptr);
+    uint8_t found = 0;
+    for (uint8_t core = 0; core < BENCH_CORES; core++) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+        TaskHandle_t idleTask = xTaskGetIdleTaskHandleForCore(core);
+#else
+        TaskHandle_t idleTask = xTaskGetIdleTaskHandleForCPU(core);
+#endif
+        for (UBaseType_t i = 0; i < count; i++) {
+            if (tasks[i].xHandle == idleTask) {
+                idle[core] = tasks[i].ulRunTimeCounter;
+                found++;
+                break;
+            }
+        }
+    }
+    free(tasks);
+    return count > 0 && found == BENCH_CORES;
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+struct BenchmarkRunner {
+    struct Run {
+        BenchmarkResult result;
+        int64_t startUs;           // First byte; 0 until the transfer starts
+        int64_t endUs;             // Last byte
+        int64_t deadlineUs;        // 0 = none
+        int64_t reportUs;
+        uint64_t reportBytes;
+        uint32_t idle[BENCH_CORES];
+        bool idleValid;
+        int32_t nextId;            // UDP server sequence tracking
+        int64_t lastTransitUs;
+        float jitterUs;
+    };
+
+    static bool stopping(const Run& run, int64_t now) {
+        return EthernetManager::getInstance().benchStop || (run.deadlineUs && now >= run.deadlineUs);
+    }
+
+    static void begin(Run& run, int64_t now) {
+        run.startUs = now;
+        run.endUs = now;
+        run.reportUs = now;
+        run.idleValid = sampleIdle(run.idle);
+    }
+
+    static void publish(const Run& run, uint32_t timeoutMs) {
+        auto& inst = EthernetManager::getInstance();
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(timeoutMs));
+        if (guard) {
+            inst.benchResult = run.result;
+        }
+    }
+
+    static void measure(Run& run) {
+        int64_t elapsedUs = run.startUs ? run.endUs - run.startUs : 0;
+        run.result.durationMs = (uint32_t)(elapsedUs / 1000);
+        run.result.mbps = elapsedUs > 0 ? (float)(run.result.bytes * 8) / (float)elapsedUs : 0.0f;
+    }
+
+    // Interval log plus a live result, at most once per ETH_BENCH_INTERVAL_MS
+    static void progress(Run& run, int64_t now) {
+        if (now - run.reportUs < (int64_t)ETH_BENCH_INTERVAL_MS * 1000) return;
+
+        float mbps = (float)((run.result.bytes - run.reportBytes) * 8) / (float)(now - run.reportUs);
+        ETH_LOG_I("Benchmark %.1f-%.1f s: %.2f Mbit/s",
+                  (run.reportUs - run.startUs) / 1e6f, (now - run.startUs) / 1e6f, mbps);
+        run.reportUs = now;
+        run.reportBytes = run.result.bytes;
+
+        measure(run);
+        publish(run, ETH_MUTEX_QUICK_TIMEOUT_MS);
+    }
+
+    static void finish(Run& run) {
+        measure(run);
+
+        // Busy share of the wall time the run took, from the idle tasks' share
+        uint32_t idle[BENCH_CORES];
+        int64_t elapsedUs = esp_timer_get_time() - run.startUs;
+        if (run.startUs && run.idleValid && elapsedUs > 0 && sampleIdle(idle)) {
+            for (uint8_t core = 0; core < BENCH_CORES; core++) {
+                uint64_t idleUs = idle[core] - run.idle[core];
+                run.result.cpuLoad[core] = idleUs >= (uint64_t)elapsedUs ? 0 : (uint8_t)(100 - idleUs * 100 / elapsedUs);
+            }
+        }
+
+        uint32_t expected = run.result.datagrams + run.result.lost;
+        if (expected) {
+            run.result.lossPercent = run.result.lost * 100.0f / expected;
+        }
+        run.result.jitterMs = run.jitterUs / 1000.0f;
+    }
+
+    static int openSocket(int type) {
+        auto& inst = EthernetManager::getInstance();
+        int sock = socket(AF_INET, type, type == SOCK_STREAM ? IPPROTO_TCP : IPPROTO_UDP);
+        if (sock < 0) return -1;
+
+        // Measure Ethernet even while failover holds the default route
+        struct ifreq ifr = {};
+        if (esp_netif_get_netif_impl_name(inst.eth_netif, ifr.ifr_name) == ESP_OK) {
+            setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, &ifr, sizeof(ifr));
+        }
+
+        // Blocking calls return regularly so stopBenchmark() is seen
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = SOCKET_POLL_MS * 1000;
+        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        return sock;
+    }
+
+    static bool bindServer(int sock, uint16_t port) {
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        int reuse = 1;
+        setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        return bind(sock, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+    }
+
+    static bool tcpClient(Run& run, int sock, uint8_t* buffer) {
+        auto& inst = EthernetManager::getInstance();
+        struct sockaddr_in to = {};
+        to.sin_family = AF_INET;
+        to.sin_port = htons(inst.benchPort);
+        to.sin_addr.s_addr = inst.benchPeer;
+        if (connect(sock, (struct sockaddr*)&to, sizeof(to)) != 0) {
+            ETH_LOG_E("Benchmark: TCP connect failed (errno %d)", errno);
+            run.result.error = EthError::CONNECTION_TIMEOUT;
+            return false;
+        }
+
+        int64_t now = esp_timer_get_time();
+        begin(run, now);
+        run.deadlineUs = now + (int64_t)inst.benchDurationMs * 1000;
+        while (!stopping(run, now)) {
+            int sent = send(sock, buffer, ETH_BENCH_BUFFER_SIZE, 0);
+            now = esp_timer_get_time();
+            if (sent < 0) {
+                if (retryable(errno)) continue;
+                ETH_LOG_E("Benchmark: TCP send failed (errno %d)", errno);
+                run.result.error = EthError::NETIF_ERROR;
+                return false;
+            }
+            run.result.bytes += sent;
+            run.endUs = now;
+            progress(run, now);
+        }
+        return !inst.benchStop;
+    }
+
+    static bool tcpServer(Run& run, int sock, uint8_t* buffer) {
+        auto& inst = EthernetManager::getInstance();
+        if (!bindServer(sock, inst.benchPort) || listen(sock, 1) != 0) {
+            ETH_LOG_E("Benchmark: TCP listen on port %u failed (errno %d)", inst.benchPort, errno);
+            run.result.error = EthError::NETIF_ERROR;
+            return false;
+        }
+        ETH_LOG_I("Benchmark: TCP server on port %u", inst.benchPort);
+
+        // accept() honours SO_RCVTIMEO in lwIP
+        int client = -1;
+        int64_t now = esp_timer_get_time();
+        while (client < 0 && !stopping(run, now)) {
+            client = accept(sock, nullptr, nullptr);
+            now = esp_timer_get_time();
+            if (client < 0 && !retryable(errno)) {
+                run.result.error = EthError::NETIF_ERROR;
+                return false;
+            }
+        }
+        if (client < 0) return false;
+
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = SOCKET_POLL_MS * 1000;
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        begin(run, now);
+        bool closed = false;
+        while (!stopping(run, now)) {
+            int received = recv(client, buffer, ETH_BENCH_BUFFER_SIZE, 0);
+            now = esp_timer_get_time();
+            if (received == 0) {
+                closed = true;
+                break;
+            }
+            if (received < 0) {
+                if (retryable(errno)) continue;
+                // A reset after the data still ends the run normally
+                closed = errno == ECONNRESET;
+                break;
+            }
+            run.result.bytes += received;
+            run.endUs = now;
+            progress(run, now);
+        }
+        close(client);
+        return closed;
+    }
+
+    static bool udpClient(Run& run, int sock, uint8_t* buffer) {
+        auto& inst = EthernetManager::getInstance();
+        struct sockaddr_in to = {};
+        to.sin_family = AF_INET;
+        to.sin_port = htons(inst.benchPort);
+        to.sin_addr.s_addr = inst.benchPeer;
+
+        const int64_t intervalUs = inst.benchUdpKbps
+            ? (int64_t)ETH_BENCH_UDP_PAYLOAD * 8 * 1000 / inst.benchUdpKbps : 0;
+        const int64_t tickUs = (int64_t)portTICK_PERIOD_MS * 1000;
+
+        int64_t now = esp_timer_get_time();
+        begin(run, now);
+        run.deadlineUs = now + (int64_t)inst.benchDurationMs * 1000;
+        int64_t nextUs = now;
+        int32_t id = 0;
+        while (!stopping(run, now)) {
+            // Sleep when a tick or more ahead; up to a tick early is sent at once
+            if (intervalUs && nextUs - now > tickUs) {
+                vTaskDelay(1);
+                now = esp_timer_get_time();
+                continue;
+            }
+
+            uint32_t header[3] = {htonl((uint32_t)id), htonl((uint32_t)(now / 1000000)),
+                                  htonl((uint32_t)(now % 1000000))};
+            memcpy(buffer, header, sizeof(header));
+            int sent = sendto(sock, buffer, ETH_BENCH_UDP_PAYLOAD, 0, (struct sockaddr*)&to, sizeof(to));
+            if (sent < 0) {
+                // ENOMEM: lwIP or the driver is out of buffers; back off and retry
+                if (errno != ENOMEM && !retryable(errno)) {
+                    ETH_LOG_E("Benchmark: UDP send failed (errno %d)", errno);
+                    run.result.error = EthError::NETIF_ERROR;
+                    return false;
+                }
+                vTaskDelay(1);
+                now = esp_timer_get_time();
+                continue;
+            }
+
+            id++;
+            run.result.datagrams++;
+            run.result.bytes += sent;
+            run.endUs = now;
+            nextUs += intervalUs;
+            now = esp_timer_get_time();
+            if (nextUs < now - tickUs) {
+                nextUs = now;  // Can't keep up; don't burst to catch up later
+            }
+            progress(run, now);
+        }
+
+        // Negative ids end the run on the server (iperf 2 convention)
+        uint32_t fin = htonl((uint32_t)-(id ? id : 1));
+        memcpy(buffer, &fin, sizeof(fin));
+        for (uint8_t i = 0; i < UDP_FIN_REPEATS; i++) {
+            sendto(sock, buffer, ETH_BENCH_UDP_PAYLOAD, 0, (struct sockaddr*)&to, sizeof(to));
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        return !inst.benchStop;
+    }
+
+    static bool udpServer(Run& run, int sock, uint8_t* buffer) {
+        auto& inst = EthernetManager::getInstance();
+        if (!bindServer(sock, inst.benchPort)) {
+            ETH_LOG_E("Benchmark: UDP bind to port %u failed (errno %d)", inst.benchPort, errno);
+            run.result.error = EthError::NETIF_ERROR;
+            return false;
+        }
+        ETH_LOG_I("Benchmark: UDP server on port %u", inst.benchPort);
+
+        int64_t now = esp_timer_get_time();
+        while (!stopping(run, now)) {
+            int received = recv(sock, buffer, ETH_BENCH_BUFFER_SIZE, 0);
+            now = esp_timer_get_time();
+            if (received < 0) {
+                if (retryable(errno)) continue;
+                run.result.error = EthError::NETIF_ERROR;
+                return false;
+            }
+            if (received < (int)UDP_HEADER_LEN) continue;
+
+            uint32_t header[3];
+            memcpy(header, buffer, sizeof(header));
+            int32_t id = (int32_t)ntohl(header[0]);
+            if (id < 0) {
+                if (run.startUs) return true;
+                continue;  // End of an earlier run
+            }
+            if (!run.startUs) {
+                // Whatever arrives first starts the count; a late join is not loss
+                begin(run, now);
+                run.nextId = id;
+            }
+
+            if (id >= run.nextId) {
+                run.result.lost += id - run.nextId;
+                run.nextId = id + 1;
+            } else {
+                run.result.outOfOrder++;
+                if (run.result.lost) run.result.lost--;
+            }
+
+            // RFC 3550 jitter; the clock offset between the hosts cancels out
+            int64_t sentUs = (int64_t)ntohl(header[1]) * 1000000 + ntohl(header[2]);
+            int64_t transitUs = now - sentUs;
+            if (run.result.datagrams > 0) {
+                int64_t delta = transitUs - run.lastTransitUs;
+                float d = (float)(delta < 0 ? -delta : delta);
+                run.jitterUs += (d - run.jitterUs) / 16.0f;
+            }
+            run.lastTransitUs = transitUs;
+
+            run.result.datagrams++;
+            run.result.bytes += received;
+            run.endUs = now;
+            progress(run, now);
+        }
+        return false;
+    }
+
+    static void task(void* param) {
+        auto& inst = EthernetManager::getInstance();
+        Run run = {};
+        run.result.mode = inst.benchResult.mode;
+        run.result.running = true;
+        run.result.error = EthError::OK;
+        for (uint8_t core = 0; core < 2; core++) {
+            run.result.cpuLoad[core] = CPU_UNAVAILABLE;
+        }
+
+        bool udp = run.result.mode == EthBenchmarkMode::UDP_CLIENT || run.result.mode == EthBenchmarkMode::UDP_SERVER;
+        bool server = run.result.mode == EthBenchmarkMode::TCP_SERVER || run.result.mode == EthBenchmarkMode::UDP_SERVER;
+        if (server && inst.benchDurationMs) {
+            run.deadlineUs = esp_timer_get_time() + (int64_t)inst.benchDurationMs * 1000;
+        }
+
+        uint8_t* buffer = static_cast<uint8_t*>(calloc(1, ETH_BENCH_BUFFER_SIZE));
+        int sock = buffer ? openSocket(udp ? SOCK_DGRAM : SOCK_STREAM) : -1;
+        if (!buffer) {
+            run.result.error = EthError::MEMORY_ALLOCATION_FAILED;
+        } else if (sock < 0) {
+            run.result.error = EthError::NETIF_ERROR;
+        } else {
+            switch (run.result.mode) {
+                case EthBenchmarkMode::TCP_CLIENT: run.result.completed = tcpClient(run, sock, buffer); break;
+                case EthBenchmarkMode::TCP_SERVER: run.result.completed = tcpServer(run, sock, buffer); break;
+                case EthBenchmarkMode::UDP_CLIENT: run.result.completed = udpClient(run, sock, buffer); break;
+                case EthBenchmarkMode::UDP_SERVER: run.result.completed = udpServer(run, sock, buffer); break;
+            }
+        }
+        if (sock >= 0) close(sock);
+        free(buffer);
+
+        finish(run);
+        run.result.running = false;
+        if (run.result.error == EthError::OK) {
+            ETH_LOG_I("Benchmark %s %s: %llu bytes in %u ms, %.2f Mbit/s, CPU %u%%/%u%%",
+                      EthernetManager::benchmarkModeToString(run.result.mode),
+                      run.result.completed ? "done" : "stopped", run.result.bytes, run.result.durationMs,
+                      run.result.mbps, run.result.cpuLoad[0], run.result.cpuLoad[1]);
+            if (run.result.mode == EthBenchmarkMode::UDP_SERVER) {
+                ETH_LOG_I("Benchmark UDP: %u/%u lost (%.2f%%), %u out of order, jitter %.3f ms",
+                          run.result.lost, run.result.datagrams + run.result.lost, run.result.lossPercent,
+                          run.result.outOfOrder, run.result.jitterMs);
+            }
+        }
+
+        publish(run, ETH_MUTEX_STANDARD_TIMEOUT_MS);
+        inst.benchTask = nullptr;
+        xEventGroupSetBits(inst.ethEventGroup, EthernetManager::BIT_BENCH_DONE);
+        vTaskDelete(nullptr);
+    }
+};
+
+bool EthernetManager::startBenchmark(EthBenchmarkMode mode, IPAddress peer, uint16_t port,
+                                     uint32_t durationSec, uint32_t udpKbps) {
+    auto& inst = getInstance();
+    bool client = mode == EthBenchmarkMode::TCP_CLIENT || mode == EthBenchmarkMode::UDP_CLIENT;
+
+    if (port == 0 || (client && ((uint32_t)peer == 0 || durationSec == 0))) {
+        ETH_LOG_E("Invalid benchmark parameters");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+    if (!inst.eth_netif || !inst.ethEventGroup) {
+        ETH_LOG_E("Benchmark needs an initialized interface");
+        inst.lastError = EthError::NOT_INITIALIZED;
+        return false;
+    }
+    if (client && inst.connectionState != EthConnectionState::CONNECTED) {
+        ETH_LOG_E("Benchmark client needs a connected interface");
+        inst.lastError = EthError::NETIF_ERROR;
+        return false;
+    }
+
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for benchmark");
+        inst.lastError = EthError::MUTEX_TIMEOUT;
+        return false;
+    }
+    if (inst.benchTask) {
+        ETH_LOG_E("Benchmark already running");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    inst.benchPeer = (uint32_t)peer;
+    inst.benchPort = port;
+    inst.benchDurationMs = durationSec * 1000;
+    inst.benchUdpKbps = udpKbps;
+    inst.benchStop = false;
+    inst.benchResult = {};
+    inst.benchResult.mode = mode;
+    inst.benchResult.running = true;
+    inst.benchResult.cpuLoad[0] = CPU_UNAVAILABLE;
+    inst.benchResult.cpuLoad[1] = CPU_UNAVAILABLE;
+    xEventGroupClearBits(inst.ethEventGroup, BIT_BENCH_DONE);
+
+    // Created under the mutex so concurrent starts can't both pass the check
+    if (xTaskCreatePinnedToCore(BenchmarkRunner::task, "EthBench", ETH_BENCH_TASK_STACK, nullptr,
+                                ETH_BENCH_TASK_PRIORITY, &inst.benchTask, ETH_BENCH_TASK_CORE) != pdPASS) {
+        ETH_LOG_E("Failed to create benchmark task");
+        inst.benchTask = nullptr;
+        inst.benchResult.running = false;
+        inst.benchResult.error = EthError::MEMORY_ALLOCATION_FAILED;
+        inst.lastError = EthError::MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+
+    ETH_LOG_I("Benchmark %s started (port %u, %u s)", benchmarkModeToString(mode), port, durationSec);
+    return true;
+}
+
+void EthernetManager::stopBenchmark() {
+    getInstance().benchStop = true;  // Seen within SOCKET_POLL_MS
+}
+
+bool EthernetManager::waitForBenchmark(uint32_t timeoutMs) {
+    auto& inst = getInstance();
+    if (!inst.benchTask) return true;
+
+    xEventGroupWaitBits(inst.ethEventGroup, BIT_BENCH_DONE, pdFALSE, pdFALSE,
+                        timeoutMs == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+    return !inst.benchTask;
+}
+
+BenchmarkResult EthernetManager::getBenchmarkResult() {
+    auto& inst = getInstance();
+    BenchmarkResult result = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        result = inst.benchResult;
+    }
+    return result;
+}
+
+const char* EthernetManager::benchmarkModeToString(EthBenchmarkMode mode) {
+    switch (mode) {
+        case EthBenchmarkMode::TCP_CLIENT: return "TCP client";
+        case EthBenchmarkMode::TCP_SERVER: return "TCP server";
+        case EthBenchmarkMode::UDP_CLIENT: return "UDP client";
+        case EthBenchmarkMode::UDP_SERVER: return "UDP server";
+        default: return "UNKNOWN";
+    }
+}
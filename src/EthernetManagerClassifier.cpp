@@ -0,0 +1,132 @@
+// EthernetManagerClassifier.cpp
+// Receive classifier: token-bucket rules by destination type, ARP target and
+// EtherType, applied on the EMAC receive task before frames reach lwIP
+#include "EthernetManager.h"
+#include "EthernetManagerTokenBucket.h"
+#include "MutexGuard.h"
+
+#include <esp_timer.h>
+
+#include <lwip/netif.h>
+
+static constexpr uint32_t ETH_HEADER_LEN = 14;
+static constexpr uint16_t ETHERTYPE_ARP = 0x0806;
+static constexpr uint32_t ARP_PAYLOAD_LEN = 28;
+static constexpr uint32_t ARP_OPCODE_OFFSET = ETH_HEADER_LEN + 6;
+static constexpr uint32_t ARP_SENDER_IP_OFFSET = ETH_HEADER_LEN + 14;
+static constexpr uint32_t ARP_TARGET_IP_OFFSET = ETH_HEADER_LEN + 24;
+static constexpr uint16_t ARP_REQUEST = 1;
+
+static const uint8_t BROADCAST_MAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+void EthernetManager::setRxClassifier(bool enable) {
+    auto& inst = getInstance();
+    uint8_t rules = 0;
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for receive classifier");
+            return;
+        }
+        inst.rxClassifierEnabled = enable;
+        rules = inst.rxRuleCount;
+    }
+
+    // The hook stays in place once installed; without a driver START installs it
+    if (enable && inst.ethHandle) {
+        inst.installStackInput();
+    }
+    ETH_LOG_I("Receive classifier %s (%u rules)", enable ? "enabled" : "disabled", rules);
+}
+
+bool EthernetManager::addRxRule(EthRxMatch match, uint32_t ratePps, uint16_t burst, uint16_t etherType) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        return false;
+    }
+
+    if (inst.rxRuleCount >= ETH_MAX_RX_RULES || (match == EthRxMatch::ETHERTYPE && etherType == 0)) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    // Filled in before the count makes it visible to the receive task
+    RxRule& rule = inst.rxRules[inst.rxRuleCount];
+    rule.match = match;
+    rule.etherType = etherType;
+    rule.ratePps = ratePps;
+    rule.burstMilli = (uint32_t)(burst ? burst : 1) * TokenBucket::MILLI_TOKENS;
+    rule.tokensMilli = rule.burstMilli;
+    rule.refilledUs = esp_timer_get_time();
+    inst.rxRuleCount = inst.rxRuleCount + 1;
+    return true;
+}
+
+void EthernetManager::clearRxRules() {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.rxRuleCount = 0;
+    }
+}
+
+void EthernetManager::setStormShedding(uint32_t broadcastPps, uint32_t multicastPps, bool dropForeignArp) {
+    clearRxRules();
+
+    // ARP requests are broadcast, so the ARP rule has to come first
+    if (dropForeignArp) {
+        addRxRule(EthRxMatch::ARP_FOREIGN, 0);
+    }
+    addRxRule(EthRxMatch::BROADCAST, broadcastPps);
+    addRxRule(EthRxMatch::MULTICAST, multicastPps);
+    setRxClassifier(true);
+}
+
+bool EthernetManager::shedFrame(const uint8_t* frame, uint32_t length, esp_netif_t* netif) {
+    if (length < ETH_HEADER_LEN) return false;
+
+    bool broadcast = memcmp(frame, BROADCAST_MAC, 6) == 0;
+    bool multicast = !broadcast && (frame[0] & 0x01);
+    uint16_t etherType = ((uint16_t)frame[12] << 8) | frame[13];
+
+    bool arpForeign = false;
+    if (etherType == ETHERTYPE_ARP && length >= ETH_HEADER_LEN + ARP_PAYLOAD_LEN &&
+        (((uint16_t)frame[ARP_OPCODE_OFFSET] << 8) | frame[ARP_OPCODE_OFFSET + 1]) == ARP_REQUEST) {
+        uint32_t sender, target;
+        memcpy(&sender, frame + ARP_SENDER_IP_OFFSET, 4);
+        memcpy(&target, frame + ARP_TARGET_IP_OFFSET, 4);
+
+        // Requests for us must never be shed; without an address nothing is foreign
+        struct netif* nif = netif ? static_cast<struct netif*>(esp_netif_get_netif_impl(netif)) : nullptr;
+        uint32_t own = nif ? ip4_addr_get_u32(netif_ip4_addr(nif)) : 0;
+        if (own != 0 && target == own) return false;
+        arpForeign = own != 0 && sender != target;  // Gratuitous ARP updates caches
+    }
+
+    int64_t now = 0;
+    uint8_t count = rxRuleCount;
+    for (uint8_t i = 0; i < count; i++) {
+        RxRule& rule = rxRules[i];
+        bool match = false;
+        switch (rule.match) {
+            case EthRxMatch::BROADCAST: match = broadcast; break;
+            case EthRxMatch::MULTICAST: match = multicast; break;
+            case EthRxMatch::ARP_FOREIGN: match = arpForeign; break;
+            case EthRxMatch::ETHERTYPE: match = etherType == rule.etherType; break;
+        }
+        if (!match) continue;
+
+        if (now == 0) now = esp_timer_get_time();
+        if (TokenBucket::take(rule, now)) return false;
+
+        switch (rule.match) {
+            case EthRxMatch::BROADCAST: stats.rxShedBroadcast++; break;
+            case EthRxMatch::MULTICAST: stats.rxShedMulticast++; break;
+            case EthRxMatch::ARP_FOREIGN: stats.rxShedArp++; break;
+            case EthRxMatch::ETHERTYPE: stats.rxShedEtherType++; break;
+        }
+        return true;
+    }
+    return false;
+}
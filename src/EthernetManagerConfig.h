@@ -39,6 +39,130 @@
 #define ETH_HOSTNAME "esp32-ethernet"
 #endif
 
+// Find the PHY address on the MDIO bus at initialize() instead of trusting ETH_PHY_ADDR
+#ifndef ETH_PHY_AUTO_DETECT
+#define ETH_PHY_AUTO_DETECT 0
+#endif
+
+// Keep the PHY powered and negotiated across esp_restart()
+#ifndef ETH_WARM_START
+#define ETH_WARM_START 0
+#endif
+
+// Driver link poll period after a warm start (native backend)
+#ifndef ETH_WARM_START_LINK_POLL_MS
+#define ETH_WARM_START_LINK_POLL_MS 100
+#endif
+
+// PHY power saving: advertise EEE where supported, arm energy-detect power-down
+#ifndef ETH_PHY_EEE
+#define ETH_PHY_EEE 0
+#endif
+
+#ifndef ETH_PHY_ENERGY_DETECT
+#define ETH_PHY_ENERGY_DETECT 0
+#endif
+
+// Wake-on-LAN: GPIO wired to the PHY interrupt/PME output (-1 = no light sleep)
+#ifndef ETH_WOL_WAKE_PIN
+#define ETH_WOL_WAKE_PIN -1
+#endif
+
+#ifndef ETH_WOL_WAKE_LEVEL
+#define ETH_WOL_WAKE_LEVEL 0       // Active level of the wake pin
+#endif
+
+// Time after a light-sleep wake for the magic packet to reach the filter
+#ifndef ETH_WOL_VERIFY_MS
+#define ETH_WOL_VERIFY_MS 50
+#endif
+
+// EMAC address filtering: limit multicast to joined groups in hardware
+#ifndef ETH_HW_MULTICAST_FILTER
+#define ETH_HW_MULTICAST_FILTER 0
+#endif
+
+#ifndef ETH_MAX_MAC_FILTERS
+#define ETH_MAX_MAC_FILTERS 16     // Table size; the first 7 go in EMAC slots
+#endif
+
+// Receive classifier: rule table size and storm-shedding defaults
+#ifndef ETH_MAX_RX_RULES
+#define ETH_MAX_RX_RULES 8
+#endif
+
+#ifndef ETH_RX_BURST
+#define ETH_RX_BURST 32            // Default token bucket depth (frames)
+#endif
+
+#ifndef ETH_RX_BROADCAST_PPS
+#define ETH_RX_BROADCAST_PPS 200
+#endif
+
+#ifndef ETH_RX_MULTICAST_PPS
+#define ETH_RX_MULTICAST_PPS 500
+#endif
+
+// Traffic shaper: per-class queue depth, rule table and default bucket depth
+#ifndef ETH_SHAPER_QUEUE_DEPTH
+#define ETH_SHAPER_QUEUE_DEPTH 16
+#endif
+
+#ifndef ETH_MAX_TRAFFIC_RULES
+#define ETH_MAX_TRAFFIC_RULES 8
+#endif
+
+#ifndef ETH_SHAPER_BURST_BYTES
+#define ETH_SHAPER_BURST_BYTES 3036        // Two full frames
+#endif
+
+// 802.1Q: virtual VLAN interfaces beside the Ethernet interface
+#ifndef ETH_MAX_VLANS
+#define ETH_MAX_VLANS 4
+#endif
+
+// Throughput benchmark defaults and task settings
+#ifndef ETH_BENCH_PORT
+#define ETH_BENCH_PORT 5001                // iperf 2 default
+#endif
+
+#ifndef ETH_BENCH_DURATION_S
+#define ETH_BENCH_DURATION_S 10
+#endif
+
+#ifndef ETH_BENCH_UDP_KBPS
+#define ETH_BENCH_UDP_KBPS 50000
+#endif
+
+#ifndef ETH_BENCH_BUFFER_SIZE
+#define ETH_BENCH_BUFFER_SIZE 8192         // TCP send/receive chunk
+#endif
+
+#ifndef ETH_BENCH_UDP_PAYLOAD
+#define ETH_BENCH_UDP_PAYLOAD 1470         // iperf 2 default datagram
+#endif
+
+#ifndef ETH_BENCH_INTERVAL_MS
+#define ETH_BENCH_INTERVAL_MS 1000         // Progress log and live result update
+#endif
+
+#ifndef ETH_BENCH_TASK_STACK
+#define ETH_BENCH_TASK_STACK 4096
+#endif
+
+#ifndef ETH_BENCH_TASK_PRIORITY
+#define ETH_BENCH_TASK_PRIORITY 4
+#endif
+
+#ifndef ETH_BENCH_TASK_CORE
+#define ETH_BENCH_TASK_CORE tskNO_AFFINITY
+#endif
+
+// Driver backend: 0 = Arduino ETH object, 1 = native esp_eth/esp_netif
+#ifndef ETH_BACKEND_NATIVE
+#define ETH_BACKEND_NATIVE 0
+#endif
+
 // LAN8720A PHY Settings - Can be overridden by user
 #ifndef ETH_PHY_POWER_PIN
 #define ETH_PHY_POWER_PIN -1       // No power pin
@@ -70,6 +194,100 @@
 #define ETH_CONNECTION_TRUST_WINDOW_MS 3000
 #endif
 
+// Grace period retaining the address across short link blips (0 = off)
+#ifndef ETH_LINK_HOLD_GRACE_MS
+#define ETH_LINK_HOLD_GRACE_MS 0
+#endif
+
+// Report static-IP CONNECTED at link up instead of waiting for GOT_IP
+#ifndef ETH_STATIC_FAST_PATH
+#define ETH_STATIC_FAST_PATH 0
+#endif
+
+// Abort TCP connections bound to Ethernet once a disconnect is confirmed
+#ifndef ETH_ABORT_SOCKETS_ON_DISCONNECT
+#define ETH_ABORT_SOCKETS_ON_DISCONNECT 0
+#endif
+
+// Private event loop for the manager's handlers (0 = default loop)
+#ifndef ETH_PRIVATE_EVENT_LOOP
+#define ETH_PRIVATE_EVENT_LOOP 0
+#endif
+
+#ifndef ETH_EVENT_LOOP_QUEUE_SIZE
+#define ETH_EVENT_LOOP_QUEUE_SIZE 16
+#endif
+
+// One above the default loop task so Ethernet state changes are not queued behind it
+#ifndef ETH_EVENT_LOOP_TASK_PRIORITY
+#define ETH_EVENT_LOOP_TASK_PRIORITY 21
+#endif
+
+#ifndef ETH_EVENT_LOOP_TASK_STACK
+#define ETH_EVENT_LOOP_TASK_STACK 4096
+#endif
+
+#ifndef ETH_EVENT_LOOP_CORE
+#define ETH_EVENT_LOOP_CORE tskNO_AFFINITY
+#endif
+
+// Longest the default loop waits for room in the private queue
+#ifndef ETH_EVENT_LOOP_POST_TIMEOUT_MS
+#define ETH_EVENT_LOOP_POST_TIMEOUT_MS 10
+#endif
+
+// Link flap damping (RFC 2439 style penalty with exponential decay, opt-in)
+#ifndef ETH_ENABLE_FLAP_DAMPING
+#define ETH_ENABLE_FLAP_DAMPING 0
+#endif
+
+#ifndef ETH_FLAP_PENALTY
+#define ETH_FLAP_PENALTY 1000
+#endif
+
+#ifndef ETH_FLAP_HALF_LIFE_MS
+#define ETH_FLAP_HALF_LIFE_MS 15000
+#endif
+
+#ifndef ETH_FLAP_SUPPRESS_THRESHOLD
+#define ETH_FLAP_SUPPRESS_THRESHOLD 2500
+#endif
+
+#ifndef ETH_FLAP_REUSE_THRESHOLD
+#define ETH_FLAP_REUSE_THRESHOLD 750
+#endif
+
+#ifndef ETH_FLAP_MAX_PENALTY
+#define ETH_FLAP_MAX_PENALTY 6000   // Caps suppression at ~3 half-lives
+#endif
+
+#ifndef ETH_FLAP_CHECK_MS
+#define ETH_FLAP_CHECK_MS 1000
+#endif
+
+// Reconnect escalation: attempts spent on each recovery step before the next
+#ifndef ETH_RECOVERY_ATTEMPTS_PER_STEP
+#define ETH_RECOVERY_ATTEMPTS_PER_STEP 2
+#endif
+
+// PHY power-cycle timing (LAN8720A needs the supply low long enough to reset)
+#ifndef ETH_PHY_POWER_OFF_MS
+#define ETH_PHY_POWER_OFF_MS 100
+#endif
+
+#ifndef ETH_PHY_POWER_ON_SETTLE_MS
+#define ETH_PHY_POWER_ON_SETTLE_MS 50
+#endif
+
+// Time allowed in OBTAINING_IP before the DHCP watchdog intervenes (0 = off)
+#ifndef ETH_DHCP_WATCHDOG_MS
+#define ETH_DHCP_WATCHDOG_MS 0
+#endif
+
+#ifndef ETH_RECOVERY_TASK_STACK
+#define ETH_RECOVERY_TASK_STACK 4096
+#endif
+
 // Mutex timeouts (milliseconds)
 #ifndef ETH_MUTEX_QUICK_TIMEOUT_MS
 #define ETH_MUTEX_QUICK_TIMEOUT_MS 100
@@ -96,6 +314,111 @@
 #define ETH_MAC_ADDRESS_SIZE 6
 #endif
 
+// NVS namespace for persisted manager state (DHCP lease, PHY address, ...)
+#ifndef ETH_NVS_NAMESPACE
+#define ETH_NVS_NAMESPACE "ethmgr"
+#endif
+
+// Poll interval / attempts while waiting for the DHCP client to start on link up
+#ifndef ETH_DHCP_SEED_POLL_MS
+#define ETH_DHCP_SEED_POLL_MS 5
+#endif
+
+#ifndef ETH_DHCP_SEED_MAX_POLLS
+#define ETH_DHCP_SEED_MAX_POLLS 100
+#endif
+
+// DHCP fallback chain (DHCP -> static -> AutoIP)
+#ifndef ETH_DHCP_FALLBACK_TIMEOUT_MS
+#define ETH_DHCP_FALLBACK_TIMEOUT_MS 10000
+#endif
+
+#ifndef ETH_DHCP_RETRY_INTERVAL_MS
+#define ETH_DHCP_RETRY_INTERVAL_MS 60000
+#endif
+
+// Time a background DHCP retry waits for a lease (DISCOVER through ACK and lwIP's ARP check)
+#ifndef ETH_DHCP_PROBE_TIMEOUT_MS
+#define ETH_DHCP_PROBE_TIMEOUT_MS 4000
+#endif
+
+// ARP conflict probing (RFC 5227, shortened for embedded use)
+#ifndef ETH_ARP_PROBE_COUNT
+#define ETH_ARP_PROBE_COUNT 3
+#endif
+
+#ifndef ETH_ARP_PROBE_WAIT_MS
+#define ETH_ARP_PROBE_WAIT_MS 200
+#endif
+
+#ifndef ETH_AUTOIP_MAX_CONFLICTS
+#define ETH_AUTOIP_MAX_CONFLICTS 10
+#endif
+
+// Gratuitous ARP and gateway/peer resolution on GOT_IP (opt-in)
+#ifndef ETH_ENABLE_ARP_PREWARM
+#define ETH_ENABLE_ARP_PREWARM 0
+#endif
+
+#ifndef ETH_GARP_COUNT
+#define ETH_GARP_COUNT 2
+#endif
+
+#ifndef ETH_GARP_INTERVAL_MS
+#define ETH_GARP_INTERVAL_MS 200
+#endif
+
+#ifndef ETH_MAX_ARP_PEERS
+#define ETH_MAX_ARP_PEERS 4
+#endif
+
+// ARP table poll while prewarm targets are outstanding (one tcpip call per tick)
+#ifndef ETH_ARP_POLL_MS
+#define ETH_ARP_POLL_MS 10
+#endif
+
+#ifndef ETH_ARP_PREWARM_TIMEOUT_MS
+#define ETH_ARP_PREWARM_TIMEOUT_MS 1000
+#endif
+
+// Layer-3 health monitor (ICMP echo to gateway / target)
+#ifndef ETH_HEALTH_INTERVAL_MS
+#define ETH_HEALTH_INTERVAL_MS 10000
+#endif
+
+#ifndef ETH_HEALTH_FAST_INTERVAL_MS
+#define ETH_HEALTH_FAST_INTERVAL_MS 1000
+#endif
+
+#ifndef ETH_HEALTH_PROBE_TIMEOUT_MS
+#define ETH_HEALTH_PROBE_TIMEOUT_MS 500
+#endif
+
+#ifndef ETH_HEALTH_FAIL_THRESHOLD
+#define ETH_HEALTH_FAIL_THRESHOLD 3
+#endif
+
+#ifndef ETH_HEALTH_RECOVER_THRESHOLD
+#define ETH_HEALTH_RECOVER_THRESHOLD 2
+#endif
+
+#ifndef ETH_HEALTH_WINDOW
+#define ETH_HEALTH_WINDOW 20       // Probes in the recent-loss window (max 32)
+#endif
+
+#ifndef ETH_HEALTH_TASK_STACK
+#define ETH_HEALTH_TASK_STACK 3072
+#endif
+
+#ifndef ETH_FALLBACK_TASK_STACK
+#define ETH_FALLBACK_TASK_STACK 3072
+#endif
+
+// IPv6 addresses tracked per netif (matches lwIP LWIP_IPV6_NUM_ADDRESSES)
+#ifndef ETH_MAX_IPV6_ADDRESSES
+#define ETH_MAX_IPV6_ADDRESSES 3
+#endif
+
 // Wait chunk for connection polling
 #ifndef ETH_WAIT_CHUNK_MS
 #define ETH_WAIT_CHUNK_MS 100
@@ -106,6 +429,16 @@
 #define ETH_EVENT_BATCH_WINDOW_MS 50
 #endif
 
+// Ethernet -> WiFi STA failover (pulls in the WiFi library when enabled)
+#ifndef ETH_ENABLE_WIFI_FAILOVER
+#define ETH_ENABLE_WIFI_FAILOVER 0
+#endif
+
+// Time Ethernet must stay CONNECTED before the default route returns to it
+#ifndef ETH_FAILOVER_RETURN_STABLE_MS
+#define ETH_FAILOVER_RETURN_STABLE_MS 10000
+#endif
+
 // Include logging configuration
 #include "EthernetManagerLogging.h"
 
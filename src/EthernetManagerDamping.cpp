@@ -0,0 +1,122 @@
+// EthernetManagerDamping.cpp
+// BGP-style link flap damping: decaying penalty, suppress and reuse thresholds
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <math.h>
+
+void EthernetManager::setFlapDamping(bool enable, uint32_t halfLifeMs,
+                                     uint32_t suppressThreshold, uint32_t reuseThreshold) {
+    auto& inst = getInstance();
+
+    if (enable && (halfLifeMs == 0 || reuseThreshold >= suppressThreshold ||
+                   suppressThreshold > ETH_FLAP_MAX_PENALTY)) {
+        ETH_LOG_E("Invalid flap damping parameters");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return;
+    }
+
+    bool release = false;
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for flap damping");
+            return;
+        }
+
+        inst.flapDampingEnabled = enable;
+        inst.flapHalfLifeMs = halfLifeMs;
+        inst.flapSuppressThreshold = suppressThreshold;
+        inst.flapReuseThreshold = reuseThreshold;
+        if (!enable) {
+            inst.flapPenalty = 0.0f;
+            release = inst.linkSuppressed;
+        }
+    }
+
+    // Report the real state at once when damping is turned off mid-suppression
+    if (release && inst.flapReuseTimer) {
+        flapReuseTimerCallback(inst.flapReuseTimer);
+    }
+}
+
+FlapStats EthernetManager::getFlapStats() {
+    auto& inst = getInstance();
+    FlapStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        currentStats = inst.flapStats;
+        currentStats.currentPenalty = (uint32_t)inst.decayFlapPenalty();
+        currentStats.suppressed = inst.linkSuppressed;
+        if (inst.linkSuppressed) {
+            currentStats.suppressedMs += millis() - inst.suppressedSince;
+        }
+    }
+    return currentStats;
+}
+
+float EthernetManager::decayFlapPenalty() {
+    uint32_t now = millis();
+    if (flapPenalty > 0.0f && flapHalfLifeMs > 0) {
+        flapPenalty *= exp2f(-(float)(now - flapPenaltyUpdated) / (float)flapHalfLifeMs);
+    }
+    flapPenaltyUpdated = now;
+    return flapPenalty;
+}
+
+void EthernetManager::recordFlap() {
+    flapStats.flapCount++;
+    if (!flapDampingEnabled) return;
+
+    float penalty = decayFlapPenalty() + ETH_FLAP_PENALTY;
+    flapPenalty = penalty < ETH_FLAP_MAX_PENALTY ? penalty : ETH_FLAP_MAX_PENALTY;
+
+    if (linkSuppressed || flapPenalty < flapSuppressThreshold) {
+        return;
+    }
+
+    if (!flapReuseTimer) {
+        flapReuseTimer = xTimerCreate("EthFlapReuse", pdMS_TO_TICKS(ETH_FLAP_CHECK_MS), pdTRUE,
+                                      nullptr, flapReuseTimerCallback);
+        if (!flapReuseTimer) {
+            ETH_LOG_E("Failed to create flap damping timer");
+            return;
+        }
+    }
+
+    linkSuppressed = true;
+    suppressedSince = millis();
+    flapStats.suppressCount++;
+    xTimerStart(flapReuseTimer, 0);
+
+    ETH_LOG_W("Link flapping (penalty %u) - holding LINK_DOWN until it settles", (uint32_t)flapPenalty);
+}
+
+void EthernetManager::flapReuseTimerCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+
+    if (inst.flapDampingEnabled && inst.decayFlapPenalty() >= inst.flapReuseThreshold) {
+        return;
+    }
+
+    xTimerStop(xTimer, 0);
+    if (!inst.linkSuppressed) return;
+
+    inst.linkSuppressed = false;
+    inst.flapStats.suppressedMs += millis() - inst.suppressedSince;
+    ETH_LOG_I("Link damping released after %lu ms", millis() - inst.suppressedSince);
+
+    // Report whatever the link is doing now
+    bool linkUp = inst.updateLinkStatus();
+    if (!linkUp) {
+        if (inst.connectionState != EthConnectionState::LINK_DOWN) {
+            inst.confirmDisconnect();
+        } else {
+            inst.clearAddresses();
+        }
+    } else if (inst.readinessSatisfied()) {
+        inst.evaluateReadiness(true);
+    } else {
+        inst.changeState(EthConnectionState::OBTAINING_IP);
+    }
+}
@@ -0,0 +1,593 @@
+// EthernetManagerDhcp.cpp
+// DHCP client management: persisted lease, INIT-REBOOT accounting, held
+// lease restore after a link blip and timeout fallback to static / AutoIP addressing
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_netif.h>
+#include <esp_timer.h>
+#include <nvs.h>
+#include <time.h>
+
+#include <lwip/dhcp.h>
+#include <lwip/netif.h>
+#include <lwip/tcpip.h>
+
+// Epoch values below this mean SNTP has not set the clock yet
+static constexpr time_t ETH_EPOCH_VALID = 1600000000;
+
+static const char* LEASE_KEY = "lease";
+
+// Bump when DhcpLease changes; older records are ignored and overwritten
+static constexpr uint32_t LEASE_RECORD_VERSION = 1;
+
+// Lease check period while a background DHCP retry runs
+static constexpr uint32_t DHCP_RETRY_POLL_MS = 50;
+
+// Synchronous netif_set_addr() from outside the tcpip thread
+struct NetifAddrCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    ip4_addr_t ip;
+    ip4_addr_t netmask;
+    ip4_addr_t gw;
+};
+
+static err_t setNetifAddrInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<NetifAddrCall*>(call);
+    netif_set_addr(msg->nif, &msg->ip, &msg->netmask, &msg->gw);
+    return ERR_OK;
+}
+
+// Bound lease details read from the client on the tcpip thread
+struct LeaseCaptureCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    bool bound;
+    uint32_t server;
+    uint32_t leaseTimeS;
+};
+
+static err_t readLeaseInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<LeaseCaptureCall*>(call);
+    struct dhcp* dhcp = netif_dhcp_data(msg->nif);
+    msg->bound = dhcp && dhcp->state == DHCP_STATE_BOUND;
+    if (msg->bound) {
+        msg->server = ip4_addr_get_u32(ip_2_ip4(&dhcp->server_ip_addr));
+        msg->leaseTimeS = dhcp->offered_t0_lease;
+    }
+    return ERR_OK;
+}
+
+void EthernetManager::setDhcpLeaseCache(bool enable) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for lease cache");
+        return;
+    }
+
+#if !CONFIG_LWIP_DHCP_RESTORE_LAST_IP
+    // Nothing would REQUEST the stored address: DHCP always runs discovery
+    if (enable) {
+        ETH_LOG_E("DHCP lease cache needs CONFIG_LWIP_DHCP_RESTORE_LAST_IP");
+        inst.lastError = EthError::CONFIG_FAILED;
+        return;
+    }
+#endif
+
+    inst.leaseCacheEnabled = enable;
+    if (enable && !inst.createLeaseSeedTimer()) {
+        inst.leaseCacheEnabled = false;
+        return;
+    }
+
+    if (enable) {
+        inst.loadLease();
+    }
+    ETH_LOG_I("DHCP lease cache %s", inst.leaseCacheEnabled ? "enabled" : "disabled");
+}
+
+void EthernetManager::clearDhcpLeaseCache() {
+    auto& inst = getInstance();
+    nvs_handle_t handle;
+    if (nvs_open(ETH_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        nvs_erase_key(handle, LEASE_KEY);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+    inst.leaseLoaded = false;
+    memset(&inst.cachedLease, 0, sizeof(inst.cachedLease));
+    ETH_LOG_I("DHCP lease cache cleared");
+}
+
+bool EthernetManager::loadLease() {
+    leaseLoaded = false;
+
+    nvs_handle_t handle;
+    if (nvs_open(ETH_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+
+    LeaseRecord record = {};
+    size_t len = sizeof(record);
+    esp_err_t err = nvs_get_blob(handle, LEASE_KEY, &record, &len);
+    nvs_close(handle);
+
+    // A record from another firmware layout is treated as no lease
+    const DhcpLease& lease = record.lease;
+    if (err != ESP_OK || len != sizeof(record) || record.version != LEASE_RECORD_VERSION || lease.ip == 0) {
+        return false;
+    }
+
+    // Skip a lease we know has expired; unknown age is still worth one REQUEST
+    time_t now = time(nullptr);
+    if (now > ETH_EPOCH_VALID && lease.obtainedEpoch > ETH_EPOCH_VALID &&
+        (uint32_t)(now - lease.obtainedEpoch) > lease.leaseTimeS) {
+        ETH_LOG_D("Cached DHCP lease expired, using full discovery");
+        return false;
+    }
+
+    cachedLease = lease;
+    leaseLoaded = true;
+    ETH_LOG_D("Loaded cached DHCP lease " IPSTR " (lease %u s)",
+              IP2STR((esp_ip4_addr_t*)&cachedLease.ip), cachedLease.leaseTimeS);
+    return true;
+}
+
+void EthernetManager::saveLease(const DhcpLease& lease) {
+    // Only touch flash when the binding changed or the stored obtain time is
+    // older than half the lease (keeps the expiry check meaningful)
+    bool sameBinding = leaseLoaded && cachedLease.ip == lease.ip && cachedLease.server == lease.server &&
+                       cachedLease.gateway == lease.gateway && cachedLease.leaseTimeS == lease.leaseTimeS;
+    bool obtainFresh = lease.obtainedEpoch == 0 || (cachedLease.obtainedEpoch != 0 &&
+                       lease.obtainedEpoch - cachedLease.obtainedEpoch < lease.leaseTimeS / 2);
+    if (sameBinding && obtainFresh) {
+        return;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(ETH_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        ETH_LOG_W("Failed to open NVS for lease: %d", err);
+        return;
+    }
+
+    LeaseRecord record = {LEASE_RECORD_VERSION, lease};
+    err = nvs_set_blob(handle, LEASE_KEY, &record, sizeof(record));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (err != ESP_OK) {
+        ETH_LOG_W("Failed to persist DHCP lease: %d", err);
+        return;
+    }
+
+    cachedLease = lease;
+    leaseLoaded = true;
+}
+
+bool EthernetManager::createLeaseSeedTimer() {
+    if (leaseSeedTimer) return true;
+
+    leaseSeedTimer = xTimerCreate("EthLeaseSeed", pdMS_TO_TICKS(ETH_DHCP_SEED_POLL_MS),
+                                  pdTRUE, nullptr, leaseSeedTimerCallback);
+    if (!leaseSeedTimer) {
+        ETH_LOG_E("Failed to create lease seed timer");
+        return false;
+    }
+    return true;
+}
+
+void EthernetManager::startLeaseSeed() {
+    leaseRebooted = false;
+    leaseRebootIp = 0;
+    if (!(leaseCacheEnabled || sleepLeasePending) || !leaseSeedTimer || !eth_netif) return;
+
+    // Only a trusted sleep lease is put on the netif ahead of the ACK; with
+    // the lease cache the poll still notes whether lwIP sent INIT-REBOOT
+    if (!(sleepLeasePending && sleepLeaseTrusted && leaseLoaded)) {
+        sleepLeasePending = false;
+        if (!leaseCacheEnabled) return;
+    }
+    leaseSeedPolls = 0;
+    xTimerStart(leaseSeedTimer, 0);
+}
+
+void EthernetManager::leaseSeedTimerCallback(TimerHandle_t xTimer) {
+    // DHCP state belongs to the tcpip thread
+    if (tcpip_callback(seedLeaseInTcpip, nullptr) != ERR_OK) {
+        ETH_LOG_D("tcpip queue full, retrying lease seed");
+    }
+}
+
+void EthernetManager::seedLeaseInTcpip(void* ctx) {
+    auto& inst = getInstance();
+    struct netif* nif = inst.eth_netif ?
+        static_cast<struct netif*>(esp_netif_get_netif_impl(inst.eth_netif)) : nullptr;
+
+    // esp_netif starts the DHCP client from its own CONNECTED handler and
+    // clears the address when it does; anything put back earlier is lost
+    esp_netif_dhcp_status_t status = ESP_NETIF_DHCP_INIT;
+    if (!nif || esp_netif_dhcpc_get_status(inst.eth_netif, &status) != ESP_OK ||
+        status != ESP_NETIF_DHCP_STARTED) {
+        if (++inst.leaseSeedPolls >= ETH_DHCP_SEED_MAX_POLLS) {
+            xTimerStop(inst.leaseSeedTimer, 0);
+            ETH_LOG_D("DHCP client did not start, lease not restored");
+        }
+        return;
+    }
+    xTimerStop(inst.leaseSeedTimer, 0);
+
+    // IDF's restore hook makes dhcp_start() REQUEST the last bound address
+    // (INIT-REBOOT) straight away; a NAK falls back to full discovery
+    struct dhcp* dhcp = netif_dhcp_data(nif);
+    if (inst.leaseCacheEnabled && !inst.holdRestorePending && dhcp &&
+        dhcp->state == DHCP_STATE_REBOOTING) {
+        inst.leaseRebootIp = ip4_addr_get_u32(&dhcp->offered_ip_addr);
+        inst.leaseRebooted = true;
+    }
+
+    // Link came back within the hold grace period: put the held binding back
+    // on the netif now; the running DHCP exchange confirms or replaces it
+    if (inst.holdRestorePending) {
+        inst.holdRestorePending = false;
+        if (inst.connectionState == EthConnectionState::LINK_DOWN_HOLDING) {
+            inst.restoreLeaseOnNetif(nif, inst.heldLease);
+
+            // State changes and callbacks belong to the timer task, not tcpip
+            if (xTimerPendFunctionCall(resumeFromHoldDeferred, nullptr, 0, 0) != pdPASS) {
+                ETH_LOG_W("Timer queue full, hold resumes on DHCP confirmation");
+            }
+            return;
+        }
+    }
+
+    // Woken from deep sleep inside T1: the snapshot lease goes straight back
+    // on the netif, as after a held blip
+    bool fromSleep = inst.sleepLeasePending;
+    inst.sleepLeasePending = false;
+    if (fromSleep && inst.sleepLeaseTrusted && inst.leaseLoaded && !dhcp_supplied_address(nif)) {
+        inst.heldLease = inst.cachedLease;
+        inst.restoreLeaseOnNetif(nif, inst.heldLease);
+        if (xTimerPendFunctionCall(resumeSleepLeaseDeferred, nullptr, 0, 0) != pdPASS) {
+            inst.holdConfirmPending = false;  // Announce on the DHCP ACK instead
+            ETH_LOG_W("Timer queue full, sleep lease resumes on DHCP confirmation");
+        }
+    }
+}
+
+void EthernetManager::restoreLeaseOnNetif(struct netif* nif, const DhcpLease& lease) {
+    // Public netif API only: the DHCP client keeps its own state and the next
+    // GOT_IP for this address is its confirmation (see consumeHeldAddress())
+    ip4_addr_t ip, netmask, gw;
+    ip4_addr_set_u32(&ip, lease.ip);
+    ip4_addr_set_u32(&netmask, lease.netmask);
+    ip4_addr_set_u32(&gw, lease.gateway);
+    netif_set_addr(nif, &ip, &netmask, &gw);
+    holdConfirmPending = true;
+}
+
+void EthernetManager::handleDhcpLease(uint32_t ip) {
+    if (dhcpFallbackTimer) {
+        xTimerStop(dhcpFallbackTimer, 0);
+    }
+
+    // Addresses we assigned ourselves are not leases
+    if (fallbackActive && ip == fallbackAppliedIp) {
+        addressSource = fallbackAppliedSource;
+        return;
+    }
+    if (fallbackActive) {
+        ETH_LOG_I("DHCP lease bound, leaving fallback address");
+        fallbackActive = false;
+    }
+    addressSource = staticIpMode ? EthAddressSource::STATIC : EthAddressSource::DHCP;
+    if (staticIpMode) {
+        return;
+    }
+
+    if (connectionStartTime > 0) {
+        lastLinkToIpMs = millis() - connectionStartTime;
+        bool cached = leaseRebooted && ip == leaseRebootIp;
+        if (cached) {
+            linkToIpCachedTotalMs += lastLinkToIpMs;
+            linkToIpCachedCount++;
+        } else {
+            if (leaseRebooted) {
+                leaseCacheMisses++;
+            }
+            linkToIpUncachedTotalMs += lastLinkToIpMs;
+            linkToIpUncachedCount++;
+        }
+        ETH_LOG_D("Link to IP in %u ms (%s)", lastLinkToIpMs, cached ? "cached lease" : "full DHCP");
+    }
+    leaseRebooted = false;
+
+    persistLease();
+}
+
+void EthernetManager::persistLease() {
+    if (!leaseCacheEnabled) return;
+
+    DhcpLease lease;
+    if (captureLease(lease)) {
+        saveLease(lease);
+    }
+}
+
+bool EthernetManager::captureLease(DhcpLease& lease) {
+    if (!eth_netif) return false;
+
+    struct netif* nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (!nif) return false;
+
+    // Lease details live in the lwIP client, which the tcpip thread owns
+    LeaseCaptureCall msg = {};
+    msg.nif = nif;
+    tcpip_api_call(readLeaseInTcpip, &msg.call);
+    if (!msg.bound) {
+        return false;  // Static configuration, nothing to persist
+    }
+
+    esp_netif_ip_info_t info;
+    if (esp_netif_get_ip_info(eth_netif, &info) != ESP_OK) {
+        return false;
+    }
+
+    lease = {};
+    lease.ip = info.ip.addr;
+    lease.netmask = info.netmask.addr;
+    lease.gateway = info.gw.addr;
+    lease.server = msg.server;
+    lease.leaseTimeS = msg.leaseTimeS;
+    time_t now = time(nullptr);
+    lease.obtainedEpoch = now > ETH_EPOCH_VALID ? (uint32_t)now : 0;
+    return true;
+}
+
+bool EthernetManager::leaseWithinRenewal(const DhcpLease& lease) const {
+    // Unknown age is never trusted; RTC time keeps running through deep sleep
+    time_t now = time(nullptr);
+    return now > ETH_EPOCH_VALID && lease.obtainedEpoch > ETH_EPOCH_VALID &&
+           (uint32_t)(now - lease.obtainedEpoch) < lease.leaseTimeS / 2;
+}
+
+void EthernetManager::setDhcpFallback(uint32_t dhcpTimeoutMs, bool autoIp, uint32_t retryIntervalMs,
+                                      IPAddress ip, IPAddress gw, IPAddress mask, IPAddress dns) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for DHCP fallback");
+        return;
+    }
+
+    inst.dhcpFallbackTimeout = dhcpTimeoutMs;
+    inst.fallbackAutoIp = autoIp;
+    inst.dhcpRetryInterval = retryIntervalMs > 0 ? retryIntervalMs : ETH_DHCP_RETRY_INTERVAL_MS;
+    inst.fallbackIp = (uint32_t)ip;
+    inst.fallbackGateway = (uint32_t)gw;
+    inst.fallbackNetmask = (uint32_t)mask;
+    inst.fallbackDns = (uint32_t)dns;
+
+    if (dhcpTimeoutMs > 0 && !inst.dhcpFallbackTimer) {
+        inst.dhcpFallbackTimer = xTimerCreate("EthDhcpFallback", pdMS_TO_TICKS(dhcpTimeoutMs),
+                                              pdFALSE, nullptr, dhcpFallbackTimerCallback);
+        if (!inst.dhcpFallbackTimer) {
+            ETH_LOG_E("Failed to create DHCP fallback timer");
+            inst.dhcpFallbackTimeout = 0;
+            return;
+        }
+    }
+
+    if (dhcpTimeoutMs > 0) {
+        ETH_LOG_I("DHCP fallback after %u ms (static %s, AutoIP %s)", dhcpTimeoutMs,
+                  inst.fallbackIp ? ip.toString().c_str() : "none", autoIp ? "on" : "off");
+    }
+}
+
+void EthernetManager::armDhcpFallback() {
+    if (staticIpMode || dhcpFallbackTimeout == 0 || !dhcpFallbackTimer) return;
+
+    xTimerChangePeriod(dhcpFallbackTimer, pdMS_TO_TICKS(dhcpFallbackTimeout), 0);
+    xTimerStart(dhcpFallbackTimer, 0);
+}
+
+void EthernetManager::dhcpFallbackTimerCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+    if (!inst.ethEventGroup || (xEventGroupGetBits(inst.ethEventGroup) & BIT_GOT_IP4)) {
+        return;
+    }
+
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        xTimerStart(xTimer, 0);  // Try again next period
+        return;
+    }
+    if (inst.dhcpFallbackTimeout == 0) return;  // Disabled or cleanup() running
+
+    ETH_LOG_W("No DHCP lease after %u ms, starting fallback", inst.dhcpFallbackTimeout);
+
+    // Probing blocks for ARP replies, so it runs in its own task
+    if (inst.fallbackTask) {
+        xTaskNotifyGive(inst.fallbackTask);
+        return;
+    }
+    xEventGroupClearBits(inst.ethEventGroup, BIT_FALLBACK_DONE);
+    if (xTaskCreate(fallbackTaskFunc, "EthFallback", ETH_FALLBACK_TASK_STACK, nullptr,
+                    tskIDLE_PRIORITY + 2, &inst.fallbackTask) != pdPASS) {
+        ETH_LOG_E("Failed to create fallback task");
+        inst.fallbackTask = nullptr;
+        xEventGroupSetBits(inst.ethEventGroup, BIT_FALLBACK_DONE);
+    }
+}
+
+void EthernetManager::stopFallback() {
+    if (dhcpFallbackTimer) {
+        xTimerStop(dhcpFallbackTimer, 0);
+    }
+
+    TaskHandle_t task = nullptr;
+    {
+        MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard) return;
+        dhcpFallbackTimeout = 0;  // Task loop condition
+        task = fallbackTask;
+        if (task) {
+            xTaskNotifyGive(task);  // Cut the retry sleep short
+        }
+    }
+
+    // An ARP probe or DHCP retry in progress runs to its own timeout
+    if (task && ethEventGroup) {
+        EventBits_t bits = xEventGroupWaitBits(ethEventGroup, BIT_FALLBACK_DONE, pdFALSE, pdFALSE,
+                                               pdMS_TO_TICKS(ETH_INIT_TIMEOUT_MS));
+        if (!(bits & BIT_FALLBACK_DONE)) {
+            ETH_LOG_W("Fallback task still running");
+        }
+    }
+}
+
+void EthernetManager::fallbackTaskFunc(void* param) {
+    auto& inst = getInstance();
+    bool apply = true;
+
+    while (inst.phyStarted && inst.dhcpFallbackTimeout > 0) {
+        if (apply && !inst.applyFallbackAddress()) {
+            ETH_LOG_E("No usable fallback address");
+        }
+
+        // Woken early when a later link up needs the fallback again
+        apply = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(inst.dhcpRetryInterval)) > 0;
+        if (apply) continue;
+
+        if (!inst.fallbackActive) break;  // A lease was bound meanwhile
+        if (!EthBackend::linkUp()) continue;
+
+        if (inst.retryDhcp()) {
+            ETH_LOG_I("DHCP lease bound, fallback ended");
+            break;
+        }
+    }
+
+    // Cleared under the lock the timer callback creates the task with
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        inst.fallbackTask = nullptr;
+        if (inst.ethEventGroup) {
+            xEventGroupSetBits(inst.ethEventGroup, BIT_FALLBACK_DONE);
+        }
+    }
+    vTaskDelete(nullptr);
+}
+
+bool EthernetManager::applyFallbackAddress() {
+    if (!eth_netif) return false;
+
+    // DHCP must not overwrite the address while we hold it
+    esp_netif_dhcpc_stop(eth_netif);
+    stats.dhcpFallbacks++;
+
+    if (fallbackIp != 0) {
+        if (!arpProbeConflict(fallbackIp)) {
+            return applyIPv4(fallbackIp, fallbackNetmask, fallbackGateway, fallbackDns,
+                             EthAddressSource::FALLBACK_STATIC);
+        }
+        ETH_LOG_W("Fallback static address in use");
+    }
+
+    if (!fallbackAutoIp) return false;
+
+    // RFC 3927: pseudo-random 169.254.1.0 - 169.254.254.255 seeded from the MAC
+    // so a device tends to reclaim the same address after every fallback
+    uint8_t mac[ETH_MAC_ADDRESS_SIZE] = {0};
+    esp_netif_get_mac(eth_netif, mac);
+    uint32_t seed = ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) |
+                    ((uint32_t)mac[4] << 8) | mac[5];
+
+    for (uint8_t attempt = 0; attempt < ETH_AUTOIP_MAX_CONFLICTS; attempt++) {
+        uint32_t candidate = nextAutoIpCandidate(seed);
+        if (!arpProbeConflict(candidate)) {
+            return applyIPv4(candidate, ESP_IP4TOADDR(255, 255, 0, 0), 0, 0, EthAddressSource::AUTOIP);
+        }
+    }
+
+    ETH_LOG_E("AutoIP gave up after %u conflicts", ETH_AUTOIP_MAX_CONFLICTS);
+    return false;
+}
+
+// Step the generator and map it onto 169.254.1.0 - 169.254.254.255
+uint32_t EthernetManager::nextAutoIpCandidate(uint32_t& seed) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t host = (seed >> 8) % (254u * 256u);
+    return ESP_IP4TOADDR(169, 254, 1 + host / 256, host % 256);
+}
+
+bool EthernetManager::applyIPv4(uint32_t ip, uint32_t netmask, uint32_t gw, uint32_t dns,
+                                EthAddressSource source) {
+    esp_netif_ip_info_t info = {};
+    info.ip.addr = ip;
+    info.netmask.addr = netmask;
+    info.gw.addr = gw;
+
+    // Set before the netif posts GOT_IP so the handler attributes the address
+    fallbackAppliedIp = ip;
+    fallbackAppliedNetmask = netmask;
+    fallbackAppliedGateway = gw;
+    fallbackAppliedSource = source;
+    fallbackActive = true;
+
+    esp_err_t err = esp_netif_set_ip_info(eth_netif, &info);
+    if (err != ESP_OK) {
+        ETH_LOG_E("Failed to apply fallback address: %d", err);
+        fallbackActive = false;
+        return false;
+    }
+
+    if (dns != 0) {
+        esp_netif_dns_info_t dnsInfo = {};
+        dnsInfo.ip.type = ESP_IPADDR_TYPE_V4;
+        dnsInfo.ip.u_addr.ip4.addr = dns;
+        esp_netif_set_dns_info(eth_netif, ESP_NETIF_DNS_MAIN, &dnsInfo);
+    }
+
+    ETH_LOG_W("Using %s address " IPSTR, source == EthAddressSource::AUTOIP ? "AutoIP" : "fallback static",
+              IP2STR(&info.ip));
+    return true;
+}
+
+bool EthernetManager::retryDhcp() {
+    if (!eth_netif) return false;
+
+    // lwIP's own client asks; esp_netif clears the address when it starts the
+    // client, so the fallback binding goes straight back on the netif and stays
+    // usable while the exchange runs (DHCP replies are accepted on any address)
+    esp_netif_dhcpc_start(eth_netif);
+    NetifAddrCall msg = {};
+    msg.nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (msg.nif) {
+        ip4_addr_set_u32(&msg.ip, fallbackAppliedIp);
+        ip4_addr_set_u32(&msg.netmask, fallbackAppliedNetmask);
+        ip4_addr_set_u32(&msg.gw, fallbackAppliedGateway);
+        tcpip_api_call(setNetifAddrInTcpip, &msg.call);
+    }
+
+    // handleDhcpLease() clears fallbackActive when a real lease binds
+    int64_t deadline = esp_timer_get_time() + (int64_t)ETH_DHCP_PROBE_TIMEOUT_MS * 1000;
+    while (fallbackActive && esp_timer_get_time() < deadline) {
+        vTaskDelay(pdMS_TO_TICKS(DHCP_RETRY_POLL_MS));
+    }
+    if (!fallbackActive) return true;
+
+    // No server: stop the client and hand the address back to esp_netif
+    esp_netif_dhcpc_stop(eth_netif);
+    esp_netif_ip_info_t info = {};
+    info.ip.addr = fallbackAppliedIp;
+    info.netmask.addr = fallbackAppliedNetmask;
+    info.gw.addr = fallbackAppliedGateway;
+    esp_netif_set_ip_info(eth_netif, &info);
+    ETH_LOG_D("DHCP retry: no lease");
+    return false;
+}
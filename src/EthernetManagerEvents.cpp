@@ -0,0 +1,302 @@
+// EthernetManagerEvents.cpp
+// Event handler registration on the default loop or a private Ethernet loop
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_eth.h>
+#include <esp_timer.h>
+
+// Probe events for measureEventDispatch(); the base is compared by pointer
+static esp_event_base_t const ETH_MANAGER_EVENT = "ETH_MANAGER_EVENT";
+static constexpr int32_t ETH_MANAGER_EVENT_PROBE = 0;
+
+namespace {
+
+// Counters are bumped by the default loop (forwarding), the private loop
+// (dispatch) and measureEventDispatch()'s caller
+portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+// The only events the manager handles; registering exact ids keeps WiFi,
+// PPP and AP traffic on the shared loop from invoking our handlers at all
+struct HandledEvent {
+    const esp_event_base_t* base;
+    int32_t id;
+};
+
+const HandledEvent HANDLED_EVENTS[] = {
+    {&ETH_EVENT, ETHERNET_EVENT_START},
+    {&ETH_EVENT, ETHERNET_EVENT_STOP},
+    {&ETH_EVENT, ETHERNET_EVENT_CONNECTED},
+    {&ETH_EVENT, ETHERNET_EVENT_DISCONNECTED},
+    {&IP_EVENT, IP_EVENT_ETH_GOT_IP},
+    {&IP_EVENT, IP_EVENT_ETH_LOST_IP},
+    {&IP_EVENT, IP_EVENT_GOT_IP6},
+#if ETH_ENABLE_WIFI_FAILOVER
+    {&IP_EVENT, IP_EVENT_STA_GOT_IP},   // Standby uplink for failover
+    {&IP_EVENT, IP_EVENT_STA_LOST_IP},
+#endif
+};
+
+// Copy of an event's payload plus the time the default loop handed it over
+struct ForwardedEvent {
+    int64_t postedUs;
+    bool hasData;
+    union {
+        esp_eth_handle_t handle;
+        ip_event_got_ip_t ip4;
+        ip_event_got_ip6_t ip6;
+    } data;
+};
+
+// Payload size of a handled event
+size_t forwardedDataSize(esp_event_base_t base, int32_t id) {
+    if (base == ETH_EVENT) {
+        return sizeof(esp_eth_handle_t);
+    }
+    return id == IP_EVENT_GOT_IP6 ? sizeof(ip_event_got_ip6_t) : sizeof(ip_event_got_ip_t);
+}
+
+// (Un)register one handler for every handled event on a loop (nullptr = default)
+esp_err_t registerHandled(esp_event_loop_handle_t loop, esp_event_handler_t handler) {
+    for (const auto& ev : HANDLED_EVENTS) {
+        esp_err_t err = loop ?
+            esp_event_handler_register_with(loop, *ev.base, ev.id, handler, nullptr) :
+            esp_event_handler_register(*ev.base, ev.id, handler, nullptr);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+void unregisterHandled(esp_event_loop_handle_t loop, esp_event_handler_t handler) {
+    for (const auto& ev : HANDLED_EVENTS) {
+        if (loop) {
+            esp_event_handler_unregister_with(loop, *ev.base, ev.id, handler);
+        } else {
+            esp_event_handler_unregister(*ev.base, ev.id, handler);
+        }
+    }
+}
+
+}  // namespace
+
+esp_err_t EthernetManager::registerEventHandlers() {
+    esp_err_t err;
+
+    if (!privateLoopEnabled) {
+        registeredLoop = nullptr;
+        err = registerHandled(nullptr, onEthEvent);
+        if (err == ESP_OK) {
+            err = esp_event_handler_register(ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE,
+                                             eventProbeHandler, nullptr);
+        }
+        if (err != ESP_OK) {
+            unregisterEventHandlers();
+        }
+        return err;
+    }
+
+    if (!privateLoop) {
+        esp_event_loop_args_t args = {};
+        args.queue_size = privateLoopQueue;
+        args.task_name = "EthEvents";
+        args.task_priority = privateLoopPriority;
+        args.task_stack_size = ETH_EVENT_LOOP_TASK_STACK;
+        args.task_core_id = privateLoopCore;
+        err = esp_event_loop_create(&args, &privateLoop);
+        if (err != ESP_OK) {
+            ETH_LOG_E("Failed to create Ethernet event loop: %d", err);
+            privateLoop = nullptr;
+            return err;
+        }
+    }
+
+    // Handlers on the private loop first, so nothing is forwarded into the void
+    registeredLoop = privateLoop;
+    err = registerHandled(privateLoop, dispatchForwardedEvent);
+    if (err == ESP_OK) {
+        err = esp_event_handler_register_with(privateLoop, ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE,
+                                              eventProbeHandler, nullptr);
+    }
+    if (err == ESP_OK) {
+        err = registerHandled(nullptr, forwardEvent);
+    }
+    if (err != ESP_OK) {
+        unregisterEventHandlers();
+    }
+    return err;
+}
+
+void EthernetManager::unregisterEventHandlers() {
+    if (!registeredLoop) {
+        unregisterHandled(nullptr, onEthEvent);
+        esp_event_handler_unregister(ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE, eventProbeHandler);
+        return;
+    }
+
+    unregisterHandled(nullptr, forwardEvent);
+    unregisterHandled(registeredLoop, dispatchForwardedEvent);
+    esp_event_handler_unregister_with(registeredLoop, ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE,
+                                      eventProbeHandler);
+    registeredLoop = nullptr;
+}
+
+bool EthernetManager::setPrivateEventLoop(bool enable, UBaseType_t priority, BaseType_t core,
+                                          uint16_t queueSize) {
+    auto& inst = getInstance();
+
+    if (enable && queueSize == 0) {
+        ETH_LOG_E("Event loop queue size must be > 0");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for event loop");
+        inst.lastError = EthError::MUTEX_TIMEOUT;
+        return false;
+    }
+
+    // Move live handlers; events queued on an old private loop are dropped
+    bool wasRegistered = inst.eventHandlersRegistered;
+    if (wasRegistered) {
+        inst.unregisterEventHandlers();
+        inst.eventHandlersRegistered = false;
+    }
+    if (inst.privateLoop) {
+        esp_event_loop_delete(inst.privateLoop);
+        inst.privateLoop = nullptr;
+    }
+
+    inst.privateLoopEnabled = enable;
+    inst.privateLoopPriority = priority;
+    inst.privateLoopCore = core;
+    inst.privateLoopQueue = queueSize;
+
+    if (!wasRegistered) {
+        return true;  // Applied by earlyInit()
+    }
+
+    esp_err_t err = inst.registerEventHandlers();
+    if (err != ESP_OK && enable) {
+        ETH_LOG_E("Private event loop failed (%d), staying on the default loop", err);
+        inst.privateLoopEnabled = false;
+        inst.registerEventHandlers();
+        inst.eventHandlersRegistered = true;
+        inst.lastError = EthError::EVENT_HANDLER_FAILED;
+        return false;
+    }
+    if (err != ESP_OK) {
+        ETH_LOG_E("Failed to register event handlers: %d", err);
+        inst.lastError = EthError::EVENT_HANDLER_FAILED;
+        return false;
+    }
+
+    inst.eventHandlersRegistered = true;
+    ETH_LOG_I("Event handlers on %s loop", enable ? "private" : "default");
+    return true;
+}
+
+void EthernetManager::forwardEvent(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    auto& inst = getInstance();
+    if (!inst.registeredLoop) return;
+    size_t len = forwardedDataSize(base, id);
+
+    ForwardedEvent fwd = {};
+    fwd.postedUs = esp_timer_get_time();
+    if (data) {
+        memcpy(&fwd.data, data, len);
+        fwd.hasData = true;
+    }
+
+    // Bounded wait: the default loop must not stall behind a busy Ethernet loop
+    if (esp_event_post_to(inst.registeredLoop, base, id, &fwd, sizeof(fwd),
+                          pdMS_TO_TICKS(ETH_EVENT_LOOP_POST_TIMEOUT_MS)) != ESP_OK) {
+        portENTER_CRITICAL(&statsLock);
+        inst.eventLoopStats.dropped++;
+        portEXIT_CRITICAL(&statsLock);
+        ETH_LOG_W("Ethernet event queue full, dropped %s:%d", base, id);
+        return;
+    }
+    portENTER_CRITICAL(&statsLock);
+    inst.eventLoopStats.forwarded++;
+    portEXIT_CRITICAL(&statsLock);
+}
+
+void EthernetManager::dispatchForwardedEvent(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    auto& inst = getInstance();
+    auto* fwd = static_cast<ForwardedEvent*>(data);
+    if (!fwd) return;
+
+    uint32_t latencyUs = (uint32_t)(esp_timer_get_time() - fwd->postedUs);
+    portENTER_CRITICAL(&statsLock);
+    inst.eventLoopStats.dispatchLastUs = latencyUs;
+    inst.dispatchTotalUs += latencyUs;
+    inst.dispatchCount++;
+    if (latencyUs > inst.eventLoopStats.dispatchMaxUs) {
+        inst.eventLoopStats.dispatchMaxUs = latencyUs;
+    }
+    portEXIT_CRITICAL(&statsLock);
+
+    onEthEvent(arg, base, id, fwd->hasData ? &fwd->data : nullptr);
+}
+
+void EthernetManager::eventProbeHandler(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    auto& inst = getInstance();
+    if (!data || !inst.ethEventGroup) return;
+
+    inst.probeLatencyUs = (uint32_t)(esp_timer_get_time() - *static_cast<int64_t*>(data));
+    xEventGroupSetBits(inst.ethEventGroup, BIT_EVENT_PROBE);
+}
+
+bool EthernetManager::measureEventDispatch(uint32_t& latencyUs, uint32_t timeoutMs) {
+    auto& inst = getInstance();
+    if (!inst.eventHandlersRegistered || !inst.ethEventGroup) {
+        inst.lastError = EthError::NOT_INITIALIZED;
+        return false;
+    }
+
+    xEventGroupClearBits(inst.ethEventGroup, BIT_EVENT_PROBE);
+    int64_t postedUs = esp_timer_get_time();
+    esp_err_t err = inst.registeredLoop ?
+        esp_event_post_to(inst.registeredLoop, ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE,
+                          &postedUs, sizeof(postedUs), pdMS_TO_TICKS(timeoutMs)) :
+        esp_event_post(ETH_MANAGER_EVENT, ETH_MANAGER_EVENT_PROBE,
+                       &postedUs, sizeof(postedUs), pdMS_TO_TICKS(timeoutMs));
+    if (err != ESP_OK) {
+        return false;
+    }
+
+    EventBits_t bits = xEventGroupWaitBits(inst.ethEventGroup, BIT_EVENT_PROBE, pdTRUE, pdFALSE,
+                                           pdMS_TO_TICKS(timeoutMs));
+    if (!(bits & BIT_EVENT_PROBE)) {
+        return false;
+    }
+
+    latencyUs = inst.probeLatencyUs;
+    portENTER_CRITICAL(&statsLock);
+    inst.eventLoopStats.probeLastUs = latencyUs;
+    if (latencyUs > inst.eventLoopStats.probeMaxUs) {
+        inst.eventLoopStats.probeMaxUs = latencyUs;
+    }
+    portEXIT_CRITICAL(&statsLock);
+    return true;
+}
+
+EventLoopStats EthernetManager::getEventLoopStats() {
+    auto& inst = getInstance();
+    EventLoopStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        portENTER_CRITICAL(&statsLock);
+        currentStats = inst.eventLoopStats;
+        uint64_t totalUs = inst.dispatchTotalUs;
+        uint32_t count = inst.dispatchCount;
+        portEXIT_CRITICAL(&statsLock);
+        currentStats.privateLoop = inst.registeredLoop != nullptr;
+        currentStats.dispatchAvgUs = count > 0 ? (uint32_t)(totalUs / count) : 0;
+    }
+    return currentStats;
+}
@@ -0,0 +1,287 @@
+// EthernetManagerFailover.cpp
+// Ethernet -> WiFi STA failover driven by the connection state machine
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_event.h>
+#include <esp_netif.h>
+#include <esp_timer.h>
+
+#if ETH_ENABLE_WIFI_FAILOVER
+#include <WiFi.h>
+#include <esp_wifi.h>
+#endif
+
+bool EthernetManager::enableFailover(const char* ssid, const char* password,
+                                     EthFailoverMode mode, uint32_t returnStableMs) {
+    auto& inst = getInstance();
+
+#if ETH_ENABLE_WIFI_FAILOVER
+    if (!ssid || strlen(ssid) == 0 || strlen(ssid) >= sizeof(inst.failoverSsid)) {
+        ETH_LOG_E("Invalid failover SSID");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    if (password && strlen(password) >= sizeof(inst.failoverPassword)) {
+        ETH_LOG_E("Failover password too long");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for failover");
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+
+        strlcpy(inst.failoverSsid, ssid, sizeof(inst.failoverSsid));
+        strlcpy(inst.failoverPassword, password ? password : "", sizeof(inst.failoverPassword));
+        inst.failoverMode = mode;
+        inst.failoverReturnStableMs = returnStableMs;
+        memset(&inst.failoverStats, 0, sizeof(inst.failoverStats));
+
+        if (!inst.failbackTimer) {
+            inst.failbackTimer = xTimerCreate("EthFailback", pdMS_TO_TICKS(returnStableMs > 0 ? returnStableMs : 1),
+                                              pdFALSE, nullptr, failbackTimerCallback);
+            if (!inst.failbackTimer) {
+                ETH_LOG_E("Failed to create failback timer");
+                inst.lastError = EthError::MEMORY_ALLOCATION_FAILED;
+                return false;
+            }
+        }
+
+        // If Ethernet is not up yet, the first WiFi IP completes a pending switchover
+        if (isConnected()) {
+            inst.activeUplink = EthUplink::ETHERNET;
+            inst.failoverPending = false;
+        } else {
+            inst.activeUplink = EthUplink::NONE;
+            inst.failoverPending = true;
+            inst.failoverStartUs = esp_timer_get_time();
+        }
+        inst.failoverEnabled = true;
+    }
+
+    // Start the standby station outside the mutex - it posts events we handle
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(mode == EthFailoverMode::PRE_ASSOCIATED);
+    WiFi.begin(inst.failoverSsid, inst.failoverPassword[0] ? inst.failoverPassword : nullptr);
+
+    ETH_LOG_I("WiFi failover enabled (SSID '%s', %s, failback after %u ms)", inst.failoverSsid,
+              mode == EthFailoverMode::PRE_ASSOCIATED ? "pre-associated" : "fast-connect",
+              returnStableMs);
+    return true;
+#else
+    (void)ssid;
+    (void)password;
+    (void)mode;
+    (void)returnStableMs;
+    ETH_LOG_W("WiFi failover not compiled in (set ETH_ENABLE_WIFI_FAILOVER=1)");
+    inst.lastError = EthError::CONFIG_FAILED;
+    return false;
+#endif
+}
+
+void EthernetManager::disableFailover() {
+    auto& inst = getInstance();
+
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for failover");
+            return;
+        }
+
+        if (!inst.failoverEnabled) {
+            return;
+        }
+
+        if (inst.failbackTimer) {
+            xTimerStop(inst.failbackTimer, 0);
+        }
+
+        if (inst.activeUplink == EthUplink::WIFI && isConnected()) {
+            inst.switchToEthernet();
+        }
+
+        inst.failoverEnabled = false;
+        inst.failoverPending = false;
+    }
+
+#if ETH_ENABLE_WIFI_FAILOVER
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+#endif
+    ETH_LOG_I("WiFi failover disabled");
+}
+
+FailoverStats EthernetManager::getFailoverStats() {
+    auto& inst = getInstance();
+    FailoverStats currentStats = {0};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        currentStats = inst.failoverStats;
+        if (inst.activeUplink == EthUplink::WIFI) {
+            currentStats.wifiUplinkMs += millis() - inst.wifiUplinkSince;
+        }
+    }
+    return currentStats;
+}
+
+void EthernetManager::handleFailoverStateChange(EthConnectionState newState) {
+#if ETH_ENABLE_WIFI_FAILOVER
+    if (!failoverEnabled) return;
+
+    switch (newState) {
+        case EthConnectionState::LINK_DOWN:
+        case EthConnectionState::LINK_DOWN_HOLDING:  // Address kept, but no wire to carry it
+        case EthConnectionState::ERROR_STATE:
+            if (failbackTimer) {
+                xTimerStop(failbackTimer, 0);
+            }
+            if (activeUplink == EthUplink::WIFI || failoverPending) {
+                break;
+            }
+
+            failoverStartUs = esp_timer_get_time();
+            if (WiFi.isConnected()) {
+                // Pre-associated standby: switchover is only a route change
+                switchToWiFi();
+            } else {
+                // Completes from handleFailoverIpEvent() once the STA has an IP
+                failoverPending = true;
+                if (failoverMode == EthFailoverMode::FAST_CONNECT) {
+                    esp_wifi_connect();
+                }
+                ETH_LOG_W("Failover pending - waiting for WiFi uplink");
+            }
+            break;
+
+        case EthConnectionState::CONNECTED:
+            failoverPending = false;
+            if (activeUplink == EthUplink::WIFI && failoverReturnStableMs > 0 && failbackTimer) {
+                // Hold on WiFi until Ethernet proves stable
+                xTimerChangePeriod(failbackTimer, pdMS_TO_TICKS(failoverReturnStableMs), 0);
+                xTimerStart(failbackTimer, 0);
+            } else {
+                switchToEthernet();
+            }
+            break;
+
+        default:
+            break;
+    }
+#else
+    (void)newState;
+#endif
+}
+
+void EthernetManager::handleFailoverIpEvent(int32_t id) {
+#if ETH_ENABLE_WIFI_FAILOVER
+    if (!failoverEnabled) return;
+
+    if (id == IP_EVENT_STA_GOT_IP) {
+        if (failoverPending) {
+            switchToWiFi();
+            return;
+        }
+
+        if (activeUplink != EthUplink::WIFI && eth_netif && isConnected()) {
+            // esp_netif promotes the higher-priority STA route on GOT_IP; keep Ethernet
+            esp_netif_set_default_netif(eth_netif);
+        }
+
+        if (failoverMode == EthFailoverMode::FAST_CONNECT && activeUplink != EthUplink::WIFI) {
+            // Cache BSSID and channel so the next association skips the scan
+            wifi_config_t conf;
+            wifi_ap_record_t ap;
+            if (esp_wifi_get_config(WIFI_IF_STA, &conf) == ESP_OK &&
+                esp_wifi_sta_get_ap_info(&ap) == ESP_OK) {
+                memcpy(conf.sta.bssid, ap.bssid, sizeof(conf.sta.bssid));
+                conf.sta.bssid_set = true;
+                conf.sta.channel = ap.primary;
+                esp_wifi_set_config(WIFI_IF_STA, &conf);
+            }
+            esp_wifi_disconnect();
+            ETH_LOG_D("Fast-connect standby cached, WiFi idle");
+        }
+    } else if (id == IP_EVENT_STA_LOST_IP) {
+        if (activeUplink == EthUplink::WIFI) {
+            ETH_LOG_W("WiFi uplink lost while carrying traffic");
+            failoverStats.wifiUplinkMs += millis() - wifiUplinkSince;
+            activeUplink = EthUplink::NONE;
+            failoverPending = true;
+            failoverStartUs = esp_timer_get_time();
+        }
+    }
+#else
+    (void)id;
+#endif
+}
+
+void EthernetManager::switchToWiFi() {
+#if ETH_ENABLE_WIFI_FAILOVER
+    esp_netif_t* staNetif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (!staNetif || esp_netif_set_default_netif(staNetif) != ESP_OK) {
+        ETH_LOG_E("Failover: could not move default route to WiFi");
+        failoverStats.failedSwitchovers++;
+        return;
+    }
+
+    uint32_t latencyUs = (uint32_t)(esp_timer_get_time() - failoverStartUs);
+    failoverPending = false;
+    activeUplink = EthUplink::WIFI;
+    wifiUplinkSince = millis();
+
+    failoverStats.switchoverCount++;
+    failoverStats.lastSwitchoverUs = latencyUs;
+    if (latencyUs > failoverStats.maxSwitchoverUs) {
+        failoverStats.maxSwitchoverUs = latencyUs;
+    }
+
+    ETH_LOG_W("Failover: default route on WiFi after %u us", latencyUs);
+#endif
+}
+
+void EthernetManager::switchToEthernet() {
+#if ETH_ENABLE_WIFI_FAILOVER
+    if (!eth_netif) return;
+
+    int64_t startUs = esp_timer_get_time();
+    if (esp_netif_set_default_netif(eth_netif) != ESP_OK) {
+        ETH_LOG_E("Failover: could not move default route to Ethernet");
+        return;
+    }
+
+    if (activeUplink == EthUplink::WIFI) {
+        failoverStats.failbackCount++;
+        failoverStats.lastFailbackUs = (uint32_t)(esp_timer_get_time() - startUs);
+        failoverStats.wifiUplinkMs += millis() - wifiUplinkSince;
+        ETH_LOG_I("Failback: default route on Ethernet after %u us", failoverStats.lastFailbackUs);
+    }
+    activeUplink = EthUplink::ETHERNET;
+
+    // Fast-connect standby goes back to idle once Ethernet carries traffic
+    if (failoverMode == EthFailoverMode::FAST_CONNECT && WiFi.isConnected()) {
+        esp_wifi_disconnect();
+    }
+#endif
+}
+
+void EthernetManager::failbackTimerCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        // Retry on the next stability window rather than blocking the timer task
+        xTimerStart(xTimer, 0);
+        return;
+    }
+
+    if (inst.failoverEnabled && inst.connectionState == EthConnectionState::CONNECTED) {
+        inst.switchToEthernet();
+    }
+}
@@ -0,0 +1,480 @@
+// EthernetManagerFilter.cpp
+// EMAC address filtering: perfect-filter slots fed from lwIP's IGMP/MLD joins,
+// broadcast and promiscuous control, and the shared driver receive hook
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_eth.h>
+
+#include <lwip/igmp.h>
+#include <lwip/mld6.h>
+#include <lwip/netif.h>
+#include <lwip/tcpip.h>
+
+#if CONFIG_IDF_TARGET_ESP32
+#include <soc/soc.h>
+
+// ESP32 EMAC MAC block, 0x1000 above the DMA registers
+static constexpr uint32_t EMAC_MAC_BASE = DR_REG_EMAC_BASE + 0x1000;
+static constexpr uint32_t EMACFF_REG = EMAC_MAC_BASE + 0x04;
+static constexpr uint32_t EMACFF_PROMISCUOUS = 1u << 0;
+static constexpr uint32_t EMACFF_PASS_ALL_MULTICAST = 1u << 4;
+static constexpr uint32_t EMACFF_DISABLE_BROADCAST = 1u << 5;
+static constexpr uint32_t EMACADDR_ENABLE = 1u << 31;
+
+static constexpr uint32_t emacAddrHigh(uint8_t n) { return EMAC_MAC_BASE + 0x40 + 8 * n; }
+static constexpr uint32_t emacAddrLow(uint8_t n) { return EMAC_MAC_BASE + 0x44 + 8 * n; }
+#endif
+
+// ADDR0 holds the station address; ADDR1..7 are ours
+static constexpr uint8_t EMAC_FILTER_SLOTS = 7;
+
+namespace {
+
+struct FilterCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    ip4_addr_t group;
+    const uint8_t* mac;
+    bool result;
+};
+
+// RFC 1112: 01:00:5E plus the low 23 bits of the group
+void ip4GroupMac(const ip4_addr_t* group, uint8_t* mac) {
+    mac[0] = 0x01;
+    mac[1] = 0x00;
+    mac[2] = 0x5E;
+    mac[3] = ip4_addr2(group) & 0x7F;
+    mac[4] = ip4_addr3(group);
+    mac[5] = ip4_addr4(group);
+}
+
+struct netif* lwipNetif(esp_netif_t* netif) {
+    return netif ? static_cast<struct netif*>(esp_netif_get_netif_impl(netif)) : nullptr;
+}
+
+// What the esp_eth glue installs: frames straight to the netif
+esp_err_t netifInput(esp_eth_handle_t handle, uint8_t* buffer, uint32_t length, void* priv) {
+    return esp_netif_receive(static_cast<esp_netif_t*>(priv), buffer, length, nullptr);
+}
+
+}  // namespace
+
+// Runs in the tcpip thread, which owns the filter table
+struct MacFilterHooks {
+#if LWIP_IGMP
+    static err_t igmpFilter(struct netif* nif, const ip4_addr_t* group, enum netif_mac_filter_action action) {
+        uint8_t mac[6];
+        ip4GroupMac(group, mac);
+        auto& inst = EthernetManager::getInstance();
+        bool ok = action == NETIF_ADD_MAC_FILTER ? inst.addFilterEntry(mac, false) :
+                                                   inst.removeFilterEntry(mac, false);
+        return ok ? ERR_OK : ERR_MEM;
+    }
+#endif
+
+#if LWIP_IPV6 && LWIP_IPV6_MLD
+    // RFC 2464: 33:33 plus the last four bytes of the group
+    static err_t mldFilter(struct netif* nif, const ip6_addr_t* group, enum netif_mac_filter_action action) {
+        uint32_t last = lwip_ntohl(group->addr[3]);
+        uint8_t mac[6] = {0x33, 0x33, (uint8_t)(last >> 24), (uint8_t)(last >> 16),
+                          (uint8_t)(last >> 8), (uint8_t)last};
+        auto& inst = EthernetManager::getInstance();
+        bool ok = action == NETIF_ADD_MAC_FILTER ? inst.addFilterEntry(mac, false) :
+                                                   inst.removeFilterEntry(mac, false);
+        return ok ? ERR_OK : ERR_MEM;
+    }
+#endif
+
+    // netif_add() resets the callbacks, and esp_netif re-adds on every start
+    static bool attached(struct netif* nif) {
+#if LWIP_IGMP
+        return nif->igmp_mac_filter == igmpFilter;
+#elif LWIP_IPV6 && LWIP_IPV6_MLD
+        return nif->mld_mac_filter == mldFilter;
+#else
+        return true;
+#endif
+    }
+
+    static void attach(struct netif* nif) {
+        auto& inst = EthernetManager::getInstance();
+
+        // Group entries are rebuilt from lwIP's lists; keep only manual ones
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < inst.macFilterCount; i++) {
+            if (inst.macFilters[i].manualRefs == 0) continue;
+            inst.macFilters[kept] = inst.macFilters[i];
+            inst.macFilters[kept].groupRefs = 0;
+            kept++;
+        }
+        inst.macFilterCount = kept;
+        inst.macFilterSpill = 0;
+
+        // Replaces any callback the netif layer set: the manager owns ADDR1..7.
+        // Groups joined before now (all-hosts, solicited-node) are replayed.
+#if LWIP_IGMP
+        netif_set_igmp_mac_filter(nif, igmpFilter);
+        for (struct igmp_group* g = netif_igmp_data(nif); g; g = g->next) {
+            igmpFilter(nif, &g->group_address, NETIF_ADD_MAC_FILTER);
+        }
+#endif
+#if LWIP_IPV6 && LWIP_IPV6_MLD
+        netif_set_mld_mac_filter(nif, mldFilter);
+        for (struct mld_group* g = netif_mld6_data(nif); g; g = g->next) {
+            mldFilter(nif, &g->group_address, NETIF_ADD_MAC_FILTER);
+        }
+#endif
+    }
+
+    static err_t restoreInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<FilterCall*>(call);
+        auto& inst = EthernetManager::getInstance();
+        if (inst.multicastFilterEnabled && msg->nif && !attached(msg->nif)) {
+            attach(msg->nif);
+        }
+        inst.programMacFilters();
+        return ERR_OK;
+    }
+
+    static err_t addInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<FilterCall*>(call);
+        msg->result = EthernetManager::getInstance().addFilterEntry(msg->mac, true);
+        return ERR_OK;
+    }
+
+    static err_t removeInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<FilterCall*>(call);
+        msg->result = EthernetManager::getInstance().removeFilterEntry(msg->mac, true);
+        return ERR_OK;
+    }
+
+#if LWIP_IGMP
+    static err_t joinInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<FilterCall*>(call);
+        msg->result = igmp_joingroup_netif(msg->nif, &msg->group) == ERR_OK;
+        return ERR_OK;
+    }
+
+    static err_t leaveInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<FilterCall*>(call);
+        msg->result = igmp_leavegroup_netif(msg->nif, &msg->group) == ERR_OK;
+        return ERR_OK;
+    }
+#endif
+};
+
+esp_err_t EthernetManager::stackInput(esp_eth_handle_t handle, uint8_t* buffer, uint32_t length, void* priv) {
+    auto& inst = getInstance();
+    if (inst.wolArmed) {
+        inst.wolFilterFrame(buffer, length);
+        return ESP_OK;
+    }
+
+    // Tagged frames are untagged and routed to their interface first
+    esp_netif_t* netif = static_cast<esp_netif_t*>(priv);
+    if (inst.vlanActive()) {
+        netif = inst.vlanInput(buffer, length, netif);
+        if (!netif) {
+            free(buffer);
+            return ESP_OK;
+        }
+    }
+
+    if ((inst.rxClassifierEnabled && inst.shedFrame(buffer, length, netif)) ||
+        (inst.shaperEnabled && inst.policeIngress(buffer, length))) {
+        free(buffer);
+        return ESP_OK;
+    }
+
+    // Everything here already passed the EMAC address filter
+    static const uint8_t broadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    if (length >= 6) {
+        if (!(buffer[0] & 0x01)) {
+            inst.macFilterStats.rxUnicast++;
+        } else if (memcmp(buffer, broadcast, 6) == 0) {
+            inst.macFilterStats.rxBroadcast++;
+        } else {
+            inst.macFilterStats.rxMulticast++;
+        }
+    }
+    return esp_netif_receive(netif, buffer, length, nullptr);
+}
+
+bool EthernetManager::installStackInput() {
+    esp_netif_t* netif = EthBackend::netif();
+    if (!ethHandle || !netif) return false;
+
+    // Replaces the glue's esp_netif_receive; frames are handed on in stackInput
+    esp_err_t err = esp_eth_update_input_path(ethHandle, stackInput, netif);
+    if (err != ESP_OK) {
+        ETH_LOG_E("Failed to install the receive hook: %d", err);
+        return false;
+    }
+    return true;
+}
+
+void EthernetManager::removeStackInput() {
+    esp_netif_t* netif = EthBackend::netif();
+    if (!ethHandle || !netif) return;
+
+    esp_err_t err = esp_eth_update_input_path(ethHandle, netifInput, netif);
+    if (err != ESP_OK) {
+        ETH_LOG_W("Failed to restore the receive path: %d", err);
+    }
+}
+
+bool EthernetManager::macFilterActive() const {
+    return multicastFilterEnabled || broadcastDropEnabled || promiscuousEnabled || macFilterCount > 0;
+}
+
+bool EthernetManager::receiveHookNeeded() const {
+    return wolEnabled || rxClassifierEnabled || shaperEnabled || vlanActive() || macFilterActive();
+}
+
+void EthernetManager::restoreReceivePath() {
+    if (!ethHandle) return;
+    if (receiveHookNeeded()) {
+        installStackInput();
+    }
+
+    FilterCall msg = {};
+    msg.nif = lwipNetif(EthBackend::netif());
+    tcpip_api_call(MacFilterHooks::restoreInTcpip, &msg.call);
+}
+
+// ESP32 only, and deliberately fragile: esp_eth has no ioctl for the perfect
+// filter slots or the frame filter bits, so the EMAC registers are written
+// directly behind the driver's back. Anything that reinitialises the EMAC
+// (driver install, esp_eth_start, a promiscuous ioctl) wipes them, which is
+// why ETHERNET_EVENT_START reprograms through restoreReceivePath().
+void EthernetManager::programMacFilters() {
+    bool overflow = macFilterCount > EMAC_FILTER_SLOTS || macFilterSpill > 0;
+    if (overflow && !macFilterOverflow && multicastFilterEnabled) {
+        macFilterStats.overflows++;
+        ETH_LOG_W("MAC filter table exceeds %u EMAC slots, passing all multicast", EMAC_FILTER_SLOTS);
+    }
+    macFilterOverflow = overflow;
+
+    macFilterStats.filters = macFilterCount;
+    macFilterStats.hardwareSlots = macFilterCount < EMAC_FILTER_SLOTS ? macFilterCount : EMAC_FILTER_SLOTS;
+    // Groups of virtual VLAN interfaces are not tracked; they need all multicast
+    macFilterStats.multicastFiltered = multicastFilterEnabled && !overflow && vlanInterfaceCount == 0;
+    macFilterStats.broadcastDropped = broadcastDropEnabled;
+    macFilterStats.promiscuous = promiscuousEnabled;
+
+    // No EMAC clock without a driver or with the PHY powered down; START reprograms
+    if (!ethHandle || phyLowPower) return;
+
+#if CONFIG_IDF_TARGET_ESP32
+    // The oldest entries hold the slots; the rest only count towards overflow
+    for (uint8_t slot = 0; slot < EMAC_FILTER_SLOTS; slot++) {
+        uint32_t high = 0, low = 0;
+        if (slot < macFilterCount) {
+            const uint8_t* mac = macFilters[slot].mac;
+            high = EMACADDR_ENABLE | ((uint32_t)mac[5] << 8) | mac[4];
+            low = ((uint32_t)mac[3] << 24) | ((uint32_t)mac[2] << 16) | ((uint32_t)mac[1] << 8) | mac[0];
+        }
+        REG_WRITE(emacAddrHigh(slot + 1), high);  // High first: the low write latches the pair
+        REG_WRITE(emacAddrLow(slot + 1), low);
+    }
+
+    uint32_t ff = REG_READ(EMACFF_REG) &
+                  ~(EMACFF_PROMISCUOUS | EMACFF_PASS_ALL_MULTICAST | EMACFF_DISABLE_BROADCAST);
+    if (!macFilterStats.multicastFiltered) ff |= EMACFF_PASS_ALL_MULTICAST;
+    if (broadcastDropEnabled) ff |= EMACFF_DISABLE_BROADCAST;
+    if (promiscuousEnabled) ff |= EMACFF_PROMISCUOUS;
+    REG_WRITE(EMACFF_REG, ff);
+#endif
+}
+
+bool EthernetManager::addFilterEntry(const uint8_t* mac, bool manual) {
+    for (uint8_t i = 0; i < macFilterCount; i++) {
+        MacFilterEntry& entry = macFilters[i];
+        if (memcmp(entry.mac, mac, 6) != 0) continue;
+        uint8_t& refs = manual ? entry.manualRefs : entry.groupRefs;
+        if (refs == UINT8_MAX) return false;
+        refs++;
+        return true;
+    }
+
+    if (macFilterCount >= ETH_MAX_MAC_FILTERS) {
+        // A group lwIP has joined must still be received
+        if (!manual && macFilterSpill++ == 0) {
+            programMacFilters();
+        }
+        return false;
+    }
+
+    MacFilterEntry& entry = macFilters[macFilterCount++];
+    memcpy(entry.mac, mac, 6);
+    entry.groupRefs = manual ? 0 : 1;
+    entry.manualRefs = manual ? 1 : 0;
+    programMacFilters();
+    return true;
+}
+
+bool EthernetManager::removeFilterEntry(const uint8_t* mac, bool manual) {
+    for (uint8_t i = 0; i < macFilterCount; i++) {
+        MacFilterEntry& entry = macFilters[i];
+        if (memcmp(entry.mac, mac, 6) != 0) continue;
+        uint8_t& refs = manual ? entry.manualRefs : entry.groupRefs;
+        if (refs == 0) return false;
+        refs--;
+        if (entry.groupRefs || entry.manualRefs) return true;
+
+        // Compact so the slots keep holding the oldest entries
+        memmove(&macFilters[i], &macFilters[i + 1], (macFilterCount - i - 1) * sizeof(MacFilterEntry));
+        macFilterCount--;
+        programMacFilters();
+        return true;
+    }
+
+    if (!manual && macFilterSpill > 0) {
+        if (--macFilterSpill == 0) {
+            programMacFilters();
+        }
+        return true;
+    }
+    return false;
+}
+
+bool EthernetManager::setMulticastFilter(bool enable) {
+    auto& inst = getInstance();
+#if !CONFIG_IDF_TARGET_ESP32
+    if (enable) {
+        ETH_LOG_E("Hardware address filtering needs the ESP32 EMAC");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+#endif
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+        inst.multicastFilterEnabled = enable;
+    }
+
+    // Without a driver the filter is applied at ETHERNET_EVENT_START
+    inst.restoreReceivePath();
+    ETH_LOG_I("Hardware multicast filter %s", enable ? "enabled" : "disabled");
+    return true;
+}
+
+bool EthernetManager::joinMulticastGroup(IPAddress group) {
+    auto& inst = getInstance();
+    FilterCall msg = {};
+    msg.nif = lwipNetif(inst.eth_netif);
+    ip4_addr_set_u32(&msg.group, (uint32_t)group);
+    if (!msg.nif || !ip4_addr_ismulticast(&msg.group)) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+#if LWIP_IGMP
+    tcpip_api_call(MacFilterHooks::joinInTcpip, &msg.call);
+#endif
+    if (!msg.result) {
+        ETH_LOG_W("Failed to join multicast group %s", group.toString().c_str());
+    }
+    return msg.result;
+}
+
+bool EthernetManager::leaveMulticastGroup(IPAddress group) {
+    auto& inst = getInstance();
+    FilterCall msg = {};
+    msg.nif = lwipNetif(inst.eth_netif);
+    ip4_addr_set_u32(&msg.group, (uint32_t)group);
+    if (!msg.nif || !ip4_addr_ismulticast(&msg.group)) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+#if LWIP_IGMP
+    tcpip_api_call(MacFilterHooks::leaveInTcpip, &msg.call);
+#endif
+    return msg.result;
+}
+
+bool EthernetManager::addMacFilter(const uint8_t* mac) {
+    auto& inst = getInstance();
+    static const uint8_t zero[6] = {0};
+    if (!mac || memcmp(mac, zero, 6) == 0 || !inst.eth_netif) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    FilterCall msg = {};
+    msg.mac = mac;
+    tcpip_api_call(MacFilterHooks::addInTcpip, &msg.call);
+    if (!msg.result) {
+        ETH_LOG_W("MAC filter table full (%u entries)", ETH_MAX_MAC_FILTERS);
+        inst.lastError = EthError::CONFIG_FAILED;
+        return false;
+    }
+    // The first entry also brings the receive counters in
+    inst.restoreReceivePath();
+    return true;
+}
+
+bool EthernetManager::removeMacFilter(const uint8_t* mac) {
+    auto& inst = getInstance();
+    if (!mac || !inst.eth_netif) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    FilterCall msg = {};
+    msg.mac = mac;
+    tcpip_api_call(MacFilterHooks::removeInTcpip, &msg.call);
+    return msg.result;
+}
+
+bool EthernetManager::setBroadcastFilter(bool drop) {
+    auto& inst = getInstance();
+#if !CONFIG_IDF_TARGET_ESP32
+    if (drop) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+#endif
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+        inst.broadcastDropEnabled = drop;
+    }
+    inst.restoreReceivePath();
+    if (drop) {
+        ETH_LOG_W("Dropping broadcast in the EMAC: ARP requests and broadcast DHCP replies are lost");
+    }
+    return true;
+}
+
+bool EthernetManager::setPromiscuous(bool enable) {
+    auto& inst = getInstance();
+#if !CONFIG_IDF_TARGET_ESP32
+    if (enable) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+#endif
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+        inst.promiscuousEnabled = enable;
+    }
+    inst.restoreReceivePath();
+    ETH_LOG_I("Promiscuous mode %s", enable ? "enabled" : "disabled");
+    return true;
+}
+
+MacFilterStats EthernetManager::getMacFilterStats() {
+    // Single-writer counters; a torn read across fields is harmless here
+    return getInstance().macFilterStats;
+}
@@ -0,0 +1,280 @@
+// EthernetManagerHealth.cpp
+// Layer-3 health monitor: ICMP echo to the gateway and an optional target
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_netif.h>
+#include <esp_timer.h>
+
+#include <lwip/inet_chksum.h>
+#include <lwip/prot/icmp.h>
+#include <lwip/prot/ip4.h>
+#include <lwip/sockets.h>
+
+static_assert(ETH_HEALTH_WINDOW > 0 && ETH_HEALTH_WINDOW <= 32, "ETH_HEALTH_WINDOW must be 1..32");
+
+static constexpr uint8_t SLOT_GATEWAY = 0;
+static constexpr uint8_t SLOT_TARGET = 1;
+static constexpr uint16_t HEALTH_ICMP_ID = 0xE7A1;
+static constexpr size_t HEALTH_PAYLOAD_SIZE = 16;
+
+bool EthernetManager::enableHealthMonitor(uint32_t intervalMs, IPAddress target, uint32_t fastIntervalMs) {
+    auto& inst = getInstance();
+
+    if (intervalMs == 0 || fastIntervalMs == 0 || fastIntervalMs > intervalMs) {
+        ETH_LOG_E("Invalid health monitor intervals");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for health monitor");
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+
+        inst.healthIntervalMs = intervalMs;
+        inst.healthFastIntervalMs = fastIntervalMs;
+        inst.healthCurrentIntervalMs = fastIntervalMs;
+        inst.healthTarget = (uint32_t)target;
+        inst.healthEnabled = true;
+    }
+
+    if (inst.healthTask) {
+        xTaskNotifyGive(inst.healthTask);  // Apply the new settings now
+        return true;
+    }
+
+    if (xTaskCreate(healthTaskFunc, "EthHealth", ETH_HEALTH_TASK_STACK, nullptr,
+                    tskIDLE_PRIORITY + 1, &inst.healthTask) != pdPASS) {
+        ETH_LOG_E("Failed to create health monitor task");
+        inst.healthTask = nullptr;
+        inst.healthEnabled = false;
+        inst.lastError = EthError::MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+
+    ETH_LOG_I("Health monitor enabled (%u/%u ms%s)", intervalMs, fastIntervalMs,
+              inst.healthTarget ? ", with target" : "");
+    return true;
+}
+
+void EthernetManager::disableHealthMonitor() {
+    auto& inst = getInstance();
+    inst.healthEnabled = false;
+    if (inst.healthTask) {
+        xTaskNotifyGive(inst.healthTask);  // Task exits on wake
+    }
+    inst.setHealth(EthHealth::UNKNOWN);
+}
+
+HealthStats EthernetManager::getHealthStats() {
+    auto& inst = getInstance();
+    HealthStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        currentStats = inst.healthStats;
+        currentStats.probeIntervalMs = inst.healthCurrentIntervalMs;
+        if (inst.health == EthHealth::DEGRADED) {
+            currentStats.degradedMs += millis() - inst.degradedSince;
+        }
+    }
+    return currentStats;
+}
+
+void EthernetManager::setHealthCallback(EthHealthCallback callback) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.healthCallback = callback;
+    }
+}
+
+void EthernetManager::setHealth(EthHealth newHealth) {
+    if (newHealth == health) return;
+
+    EthHealth oldHealth = health;
+    health = newHealth;
+
+    if (oldHealth == EthHealth::DEGRADED) {
+        healthStats.degradedMs += millis() - degradedSince;
+    }
+    if (newHealth == EthHealth::DEGRADED) {
+        degradedSince = millis();
+        healthStats.degradedEvents++;
+        ETH_LOG_W("Network DEGRADED: link up but gateway%s not answering",
+                  healthTarget ? "/target" : "");
+    } else if (newHealth == EthHealth::HEALTHY) {
+        ETH_LOG_I("Network healthy");
+    }
+
+    if (healthCallback) {
+        healthCallback(newHealth);
+    }
+}
+
+void EthernetManager::handleHealthStateChange(EthConnectionState newState) {
+    if (!healthEnabled) return;
+
+    if (newState == EthConnectionState::CONNECTED) {
+        // Probe right away instead of trusting the previous verdict
+        healthCurrentIntervalMs = healthFastIntervalMs;
+        healthGoodRounds = 0;
+        if (healthTask) {
+            xTaskNotifyGive(healthTask);
+        }
+    } else if (newState != EthConnectionState::DISCONNECTING) {
+        setHealth(EthHealth::UNKNOWN);
+    }
+}
+
+bool EthernetManager::icmpProbe(int sock, uint32_t dst, uint32_t& rttUs) {
+    uint8_t pkt[sizeof(struct icmp_echo_hdr) + HEALTH_PAYLOAD_SIZE] = {0};
+    auto* echo = reinterpret_cast<struct icmp_echo_hdr*>(pkt);
+    uint16_t seq = ++healthSeq;
+
+    ICMPH_TYPE_SET(echo, ICMP_ECHO);
+    ICMPH_CODE_SET(echo, 0);
+    echo->id = lwip_htons(HEALTH_ICMP_ID);
+    echo->seqno = lwip_htons(seq);
+    echo->chksum = 0;
+    echo->chksum = inet_chksum(pkt, sizeof(pkt));
+
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = dst;
+
+    int64_t startUs = esp_timer_get_time();
+    if (sendto(sock, pkt, sizeof(pkt), 0, (struct sockaddr*)&to, sizeof(to)) < 0) {
+        return false;
+    }
+
+    // Raw sockets return the IP header; skip stale replies from earlier rounds
+    uint8_t reply[64];
+    int64_t deadline = startUs + (int64_t)ETH_HEALTH_PROBE_TIMEOUT_MS * 1000;
+    while (esp_timer_get_time() < deadline) {
+        struct sockaddr_in from = {};
+        socklen_t fromLen = sizeof(from);
+        int len = recvfrom(sock, reply, sizeof(reply), 0, (struct sockaddr*)&from, &fromLen);
+        if (len < 0) break;  // Timeout
+        if (len < (int)sizeof(struct ip_hdr)) continue;
+
+        size_t ipLen = IPH_HL_BYTES(reinterpret_cast<struct ip_hdr*>(reply));
+        if (len < (int)(ipLen + sizeof(struct icmp_echo_hdr)) || from.sin_addr.s_addr != dst) continue;
+
+        auto* rep = reinterpret_cast<struct icmp_echo_hdr*>(reply + ipLen);
+        if (ICMPH_TYPE(rep) == ICMP_ER && rep->id == lwip_htons(HEALTH_ICMP_ID) &&
+            rep->seqno == lwip_htons(seq)) {
+            rttUs = (uint32_t)(esp_timer_get_time() - startUs);
+            return true;
+        }
+    }
+    return false;
+}
+
+void EthernetManager::recordProbe(uint8_t slot, bool ok, uint32_t rttUs) {
+    HealthProbeStats& ps = slot == SLOT_GATEWAY ? healthStats.gateway : healthStats.target;
+    constexpr uint32_t windowMask = ETH_HEALTH_WINDOW == 32 ? 0xFFFFFFFFu : ((1u << ETH_HEALTH_WINDOW) - 1);
+
+    ps.sent++;
+    healthWindow[slot] = ((healthWindow[slot] << 1) | (ok ? 0 : 1)) & windowMask;
+    uint32_t samples = ps.sent < ETH_HEALTH_WINDOW ? ps.sent : ETH_HEALTH_WINDOW;
+    ps.recentLossPercent = (uint8_t)(__builtin_popcount(healthWindow[slot]) * 100 / samples);
+
+    if (!ok) {
+        ps.lost++;
+        ps.consecutiveFailures++;
+        return;
+    }
+
+    ps.consecutiveFailures = 0;
+    ps.rttLastUs = rttUs;
+    healthRttTotalUs[slot] += rttUs;
+    healthRttCount[slot]++;
+    ps.rttAvgUs = (uint32_t)(healthRttTotalUs[slot] / healthRttCount[slot]);
+    if (ps.rttMinUs == 0 || rttUs < ps.rttMinUs) ps.rttMinUs = rttUs;
+    if (rttUs > ps.rttMaxUs) ps.rttMaxUs = rttUs;
+}
+
+void EthernetManager::healthTaskFunc(void* param) {
+    auto& inst = getInstance();
+
+    int sock = socket(AF_INET, SOCK_RAW, IPPROTO_ICMP);
+    if (sock < 0) {
+        ETH_LOG_E("Health monitor: raw socket failed");
+        inst.healthEnabled = false;
+        inst.healthTask = nullptr;
+        vTaskDelete(nullptr);
+        return;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = ETH_HEALTH_PROBE_TIMEOUT_MS / 1000;
+    tv.tv_usec = (ETH_HEALTH_PROBE_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    bool boundToEth = false;
+    while (inst.healthEnabled) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(inst.healthCurrentIntervalMs));
+        if (!inst.healthEnabled) break;
+        if (inst.connectionState != EthConnectionState::CONNECTED || !inst.eth_netif) continue;
+
+        // Probes must leave via Ethernet even while failover holds the default route
+        if (!boundToEth) {
+            struct ifreq ifr = {};
+            if (esp_netif_get_netif_impl_name(inst.eth_netif, ifr.ifr_name) == ESP_OK) {
+                boundToEth = setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, &ifr, sizeof(ifr)) == 0;
+            }
+        }
+
+        esp_netif_ip_info_t info;
+        if (esp_netif_get_ip_info(inst.eth_netif, &info) != ESP_OK || info.gw.addr == 0) continue;
+
+        uint32_t gwRtt = 0;
+        uint32_t targetRtt = 0;
+        bool gwOk = inst.icmpProbe(sock, info.gw.addr, gwRtt);
+        bool targetOk = true;
+        if (inst.healthTarget) {
+            targetOk = inst.icmpProbe(sock, inst.healthTarget, targetRtt);
+        }
+
+        EthHealth verdict = inst.health;
+        {
+            MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+            if (!guard) continue;
+
+            inst.recordProbe(SLOT_GATEWAY, gwOk, gwRtt);
+            if (inst.healthTarget) {
+                inst.recordProbe(SLOT_TARGET, targetOk, targetRtt);
+            }
+
+            // Adaptive rate: fast after any loss, doubling back to the idle interval
+            if (gwOk && targetOk) {
+                inst.healthGoodRounds++;
+                uint32_t next = inst.healthCurrentIntervalMs * 2;
+                inst.healthCurrentIntervalMs = next < inst.healthIntervalMs ? next : inst.healthIntervalMs;
+                if (inst.healthGoodRounds >= ETH_HEALTH_RECOVER_THRESHOLD || inst.health == EthHealth::UNKNOWN) {
+                    verdict = EthHealth::HEALTHY;
+                }
+            } else {
+                inst.healthGoodRounds = 0;
+                inst.healthCurrentIntervalMs = inst.healthFastIntervalMs;
+                if (inst.healthStats.gateway.consecutiveFailures >= ETH_HEALTH_FAIL_THRESHOLD ||
+                    inst.healthStats.target.consecutiveFailures >= ETH_HEALTH_FAIL_THRESHOLD) {
+                    verdict = EthHealth::DEGRADED;
+                }
+            }
+        }
+
+        // Callback runs outside the mutex so it may query the manager;
+        // a verdict reached after disableHealthMonitor() is dropped
+        if (!inst.healthEnabled) break;
+        inst.setHealth(verdict);
+    }
+
+    close(sock);
+    inst.healthTask = nullptr;
+    vTaskDelete(nullptr);
+}
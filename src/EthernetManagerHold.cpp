@@ -0,0 +1,153 @@
+// EthernetManagerHold.cpp
+// Short link blips: keep the address for a grace period, resume without DHCP
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+// Upper bounds of the blip histogram buckets (ms); the last bucket is open
+static const uint32_t BLIP_BUCKET_MS[] = {100, 250, 500, 1000, 2000, 5000, 10000};
+static_assert(sizeof(BLIP_BUCKET_MS) / sizeof(BLIP_BUCKET_MS[0]) + 1 ==
+              sizeof(BlipStats::histogram) / sizeof(BlipStats::histogram[0]),
+              "Blip histogram bucket count mismatch");
+
+void EthernetManager::setLinkHoldGrace(uint32_t graceMs) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for link hold");
+        return;
+    }
+
+    inst.linkHoldGraceMs = graceMs;
+    ETH_LOG_I("Link hold grace %s (%u ms)", graceMs ? "enabled" : "disabled", graceMs);
+}
+
+BlipStats EthernetManager::getBlipStats() {
+    auto& inst = getInstance();
+    BlipStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        currentStats = inst.blipStats;
+    }
+    return currentStats;
+}
+
+bool EthernetManager::beginLinkHold() {
+    if (linkHoldGraceMs == 0 || linkSuppressed || connectionState != EthConnectionState::CONNECTED) {
+        return false;
+    }
+
+    // Only addresses that can be put back as they were: fallback ones are re-probed
+    if ((xEventGroupGetBits(ethEventGroup) & BIT_GOT_IP4) == 0 || heldLease.ip == 0 ||
+        (addressSource != EthAddressSource::DHCP && addressSource != EthAddressSource::STATIC)) {
+        return false;
+    }
+
+    if (!holdGraceTimer) {
+        holdGraceTimer = xTimerCreate("EthLinkHold", pdMS_TO_TICKS(linkHoldGraceMs), pdFALSE,
+                                      nullptr, holdGraceTimerCallback);
+        if (!holdGraceTimer) {
+            ETH_LOG_E("Failed to create link hold timer");
+            return false;
+        }
+    }
+
+    holdStartMs = millis();
+    holdRestorePending = false;
+    holdConfirmPending = false;
+    blipStats.holds++;
+    stats.linkDownEvents++;
+
+    // Not ready while the wire is gone, but the address stays assigned
+    xEventGroupClearBits(ethEventGroup, BIT_CONNECTED);
+    changeState(EthConnectionState::LINK_DOWN_HOLDING);
+    xTimerChangePeriod(holdGraceTimer, pdMS_TO_TICKS(linkHoldGraceMs), 0);
+
+    ETH_LOG_W("Link lost - holding " IPSTR " for %u ms", IP2STR((esp_ip4_addr_t*)&heldLease.ip),
+              linkHoldGraceMs);
+    return true;
+}
+
+void EthernetManager::restoreLinkHold() {
+    // Static addresses are reposted by esp_netif; the GOT_IP resumes the hold
+    if (addressSource != EthAddressSource::DHCP) return;
+
+    // The DHCP client restarts with the link; seedLeaseInTcpip() puts the
+    // held binding back as soon as it runs
+    if (!createLeaseSeedTimer()) return;
+    holdRestorePending = true;
+    leaseSeedPolls = 0;
+    xTimerStart(leaseSeedTimer, 0);
+}
+
+void EthernetManager::resumeFromHold() {
+    if (connectionState != EthConnectionState::LINK_DOWN_HOLDING) return;
+
+    if (holdGraceTimer) {
+        xTimerStop(holdGraceTimer, 0);
+    }
+
+    uint32_t blipMs = millis() - holdStartMs;
+    uint8_t bucket = 0;
+    while (bucket < sizeof(BLIP_BUCKET_MS) / sizeof(BLIP_BUCKET_MS[0]) && blipMs > BLIP_BUCKET_MS[bucket]) {
+        bucket++;
+    }
+    blipStats.histogram[bucket]++;
+    blipStats.resumed++;
+    blipStats.lastBlipMs = blipMs;
+    if (blipMs > blipStats.maxBlipMs) {
+        blipStats.maxBlipMs = blipMs;
+    }
+
+    changeState(EthConnectionState::CONNECTED);
+    xEventGroupSetBits(ethEventGroup, BIT_CONNECTED);
+    ETH_LOG_I("Link blip of %u ms absorbed, kept " IPSTR, blipMs, IP2STR((esp_ip4_addr_t*)&heldLease.ip));
+
+    // Peers may have flushed us from their caches during the outage
+    startArpPrewarm(heldLease.ip, heldLease.netmask, heldLease.gateway);
+}
+
+void EthernetManager::resumeFromHoldDeferred(void* param1, uint32_t param2) {
+    getInstance().resumeFromHold();
+}
+
+bool EthernetManager::consumeHeldAddress(uint32_t ip) {
+    bool holding = connectionState == EthConnectionState::LINK_DOWN_HOLDING;
+    if (!holding && !holdConfirmPending) return false;
+
+    holdConfirmPending = false;
+    if (ip == heldLease.ip) {
+        // Static repost, or the background DHCP exchange confirming the binding
+        if (holding) {
+            holdRestorePending = false;
+            resumeFromHold();
+        }
+        return true;
+    }
+
+    // Different address: end the hold and announce it as a fresh connection
+    if (holding) {
+        if (holdGraceTimer) {
+            xTimerStop(holdGraceTimer, 0);
+        }
+        holdRestorePending = false;
+        blipStats.expired++;
+        changeState(EthConnectionState::OBTAINING_IP);
+    }
+    ETH_LOG_W("Held address " IPSTR " not confirmed", IP2STR((esp_ip4_addr_t*)&heldLease.ip));
+    return false;
+}
+
+void EthernetManager::holdGraceTimerCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+    if (inst.connectionState != EthConnectionState::LINK_DOWN_HOLDING) return;
+
+    inst.blipStats.expired++;
+    inst.holdRestorePending = false;
+    ETH_LOG_E("Link down for %lu ms, releasing held address", millis() - inst.holdStartMs);
+    inst.confirmDisconnect();
+
+    // Carrier came back but the address was not restored in time
+    if (EthBackend::linkUp()) {
+        inst.changeState(EthConnectionState::OBTAINING_IP);
+    }
+}
@@ -0,0 +1,216 @@
+// EthernetManagerPhyScan.cpp
+// MDIO PHY discovery: one SMI sweep of addresses 0-31, cached in NVS;
+// also provides driver-less MDIO access for the warm start check
+#include "EthernetManager.h"
+
+#include <esp_eth.h>
+#include <esp_timer.h>
+#include <nvs.h>
+
+static const char* PHY_KEY = "phy";
+
+// IEEE 802.3 clause 22 identifier registers
+static constexpr uint32_t PHY_REG_ID1 = 2;
+static constexpr uint32_t PHY_REG_ID2 = 3;
+static constexpr uint16_t PHY_ID2_REVISION_MASK = 0x000F;
+
+namespace {
+
+struct PhyCache {
+    int8_t address;
+    uint16_t id1;
+    uint16_t id2;
+};
+
+// Identifier registers with the revision nibble masked off
+struct KnownPhy {
+    uint16_t id1;
+    uint16_t id2;
+    const char* model;
+};
+
+const KnownPhy KNOWN_PHYS[] = {
+    {0x0007, 0xC0F0, "LAN8720A"},
+    {0x0007, 0xC130, "LAN8742A"},
+    {0x0243, 0x0C50, "IP101"},
+    {0x001C, 0xC810, "RTL8201"},
+    {0x2000, 0x5C90, "DP83848"},
+    {0x0022, 0x1560, "KSZ8081"},
+};
+
+bool readPhyId(esp_eth_mac_t* mac, uint8_t addr, uint16_t& id1, uint16_t& id2) {
+    uint32_t r1 = 0, r2 = 0;
+    if (mac->read_phy_reg(mac, addr, PHY_REG_ID1, &r1) != ESP_OK ||
+        mac->read_phy_reg(mac, addr, PHY_REG_ID2, &r2) != ESP_OK) {
+        return false;
+    }
+    id1 = (uint16_t)r1;
+    id2 = (uint16_t)r2;
+    // Pulled-up MDIO reads all ones with nothing there; all zeros is a stuck bus
+    return !(id1 == 0xFFFF && id2 == 0xFFFF) && !(id1 == 0 && id2 == 0);
+}
+
+bool loadPhyCache(PhyCache& cache) {
+    nvs_handle_t handle;
+    if (nvs_open(ETH_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    size_t len = sizeof(cache);
+    esp_err_t err = nvs_get_blob(handle, PHY_KEY, &cache, &len);
+    nvs_close(handle);
+    return err == ESP_OK && len == sizeof(cache) &&
+           cache.address >= 0 && cache.address <= ETH_MAX_PHY_ADDRESS;
+}
+
+void savePhyCache(const PhyCache& cache) {
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(ETH_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        ETH_LOG_W("Failed to open NVS for PHY address: %d", err);
+        return;
+    }
+    err = nvs_set_blob(handle, PHY_KEY, &cache, sizeof(cache));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ETH_LOG_W("Failed to persist PHY address: %d", err);
+    }
+}
+
+// The EMAC only needs a mediator for its low-level init; nothing is started
+esp_err_t smiStateChanged(esp_eth_mediator_t* eth, esp_eth_state_t state, void* args) {
+    return ESP_OK;
+}
+
+esp_err_t smiStackInput(esp_eth_mediator_t* eth, uint8_t* buffer, uint32_t length) {
+    free(buffer);
+    return ESP_OK;
+}
+
+esp_eth_mediator_t smiMediator = {};
+
+}  // namespace
+
+const char* EthernetManager::identifyPhy(uint16_t id1, uint16_t id2) {
+    for (const auto& phy : KNOWN_PHYS) {
+        if (phy.id1 == id1 && phy.id2 == (id2 & ~PHY_ID2_REVISION_MASK)) {
+            return phy.model;
+        }
+    }
+    return "unknown";
+}
+
+esp_eth_mac_t* ethOpenSmi(const EthBackendConfig& cfg) {
+    smiMediator.stack_input = smiStackInput;
+    smiMediator.on_state_changed = smiStateChanged;
+
+    esp_eth_mac_t* mac = ethNewEsp32Emac(cfg);
+    if (!mac) {
+        ETH_LOG_E("MDIO access: failed to create EMAC");
+        return nullptr;
+    }
+    mac->set_mediator(mac, &smiMediator);
+    if (mac->init(mac) != ESP_OK) {
+        ETH_LOG_E("MDIO access: EMAC init failed (no RMII clock?)");
+        mac->del(mac);
+        return nullptr;
+    }
+    return mac;
+}
+
+void ethCloseSmi(esp_eth_mac_t* mac) {
+    if (!mac) return;
+    mac->deinit(mac);
+    mac->del(mac);
+}
+
+bool EthernetManager::detectPhy(EthernetConfig& config, EthPhyInfo* info) {
+    auto& inst = getInstance();
+    if (inst.phyStarted) {
+        ETH_LOG_E("PHY discovery needs the EMAC; call before initialize()");
+        inst.lastError = EthError::ALREADY_INITIALIZED;
+        return false;
+    }
+
+    int64_t startUs = esp_timer_get_time();
+    EthPhyInfo result = {-1, 0, 0, "unknown", 0, false, 0};
+
+    EthBackendConfig cfg = {};
+    cfg.mdcPin = config.mdc_pin;
+    cfg.mdioPin = config.mdio_pin;
+    cfg.clockMode = config.clock_mode;
+
+    // The PHY must be clocked to answer on MDIO
+    ethPowerOnPhy(config.power_pin);
+
+    esp_eth_mac_t* mac = ethOpenSmi(cfg);
+    if (!mac) {
+        inst.lastError = EthError::PHY_START_FAILED;
+        return false;
+    }
+
+    // Last boot's address answers with the same identity: no sweep needed
+    PhyCache cache = {};
+    uint16_t id1 = 0, id2 = 0;
+    if (loadPhyCache(cache) && readPhyId(mac, cache.address, id1, id2) &&
+        id1 == cache.id1 && id2 == cache.id2) {
+        result.address = cache.address;
+        result.id1 = id1;
+        result.id2 = id2;
+        result.found = 1;
+        result.fromCache = true;
+    } else {
+        // Prefer a known chip; otherwise the first responder
+        bool known = false;
+        for (uint8_t addr = 0; addr <= ETH_MAX_PHY_ADDRESS; addr++) {
+            if (!readPhyId(mac, addr, id1, id2)) continue;
+            result.found++;
+            bool isKnown = strcmp(identifyPhy(id1, id2), "unknown") != 0;
+            if (result.address < 0 || (isKnown && !known)) {
+                result.address = addr;
+                result.id1 = id1;
+                result.id2 = id2;
+                known = isKnown;
+            }
+        }
+    }
+
+    ethCloseSmi(mac);
+
+    result.scanTimeUs = (uint32_t)(esp_timer_get_time() - startUs);
+    if (result.address < 0) {
+        ETH_LOG_E("PHY discovery: no PHY on MDIO (MDC %d, MDIO %d) after %u us",
+                  config.mdc_pin, config.mdio_pin, result.scanTimeUs);
+        inst.phyInfo = result;
+        if (info) *info = result;
+        inst.lastError = EthError::PHY_START_FAILED;
+        return false;
+    }
+
+    result.model = identifyPhy(result.id1, result.id2);
+    if (!result.fromCache) {
+        savePhyCache({result.address, result.id1, result.id2});
+    }
+    if (result.found > 1) {
+        ETH_LOG_W("PHY discovery: %u PHYs answered, using address %d", result.found, result.address);
+    }
+    ETH_LOG_I("PHY %s (%04X:%04X) at address %d, %s in %u us", result.model, result.id1, result.id2,
+              result.address, result.fromCache ? "cached" : "scanned", result.scanTimeUs);
+
+    config.phy_addr = result.address;
+    inst.phyInfo = result;
+    if (info) *info = result;
+    return true;
+}
+
+void EthernetManager::clearPhyCache() {
+    nvs_handle_t handle;
+    if (nvs_open(ETH_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        nvs_erase_key(handle, PHY_KEY);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+    ETH_LOG_I("PHY address cache cleared");
+}
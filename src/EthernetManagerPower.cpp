@@ -0,0 +1,246 @@
+// EthernetManagerPower.cpp
+// PHY power management: EEE advertisement, energy-detect power-down,
+// application low-power state and time-in-state accounting
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_eth.h>
+#include <esp_idf_version.h>
+#include <string.h>
+
+// IEEE 802.3 clause 22 registers
+static constexpr uint32_t PHY_REG_BMCR = 0;
+static constexpr uint32_t BMCR_POWER_DOWN = 0x0800;
+static constexpr uint32_t BMCR_AUTONEG_RESTART = 0x0200;
+static constexpr uint32_t PHY_REG_MMD_CTRL = 13;
+static constexpr uint32_t PHY_REG_MMD_DATA = 14;
+static constexpr uint32_t MMD_CTRL_DATA = 0x4000;      // Data, no post increment
+static constexpr uint32_t PHY_REG_ID1 = 2;
+static constexpr uint32_t PHY_REG_ID2 = 3;
+
+// LAN87xx mode control/status register
+static constexpr uint32_t PHY_REG_LAN87XX_MCSR = 17;
+static constexpr uint32_t MCSR_EDPWRDOWN = 0x2000;
+
+// Clause 45 EEE registers reached through the MMD window
+static constexpr uint16_t MMD_PCS = 3;
+static constexpr uint16_t MMD_PCS_EEE_CAPABILITY = 20;
+static constexpr uint16_t MMD_AN = 7;
+static constexpr uint16_t MMD_AN_EEE_ADVERTISEMENT = 60;
+static constexpr uint16_t MMD_AN_EEE_PARTNER = 61;
+static constexpr uint32_t EEE_100BASE_TX = 0x0002;
+
+namespace {
+
+bool readPhyReg(esp_eth_handle_t handle, uint32_t reg, uint32_t& value) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    esp_eth_phy_reg_rw_data_t rw = {reg, &value};
+    return handle && esp_eth_ioctl(handle, ETH_CMD_READ_PHY_REG, &rw) == ESP_OK;
+#else
+    return false;  // IDF 4.x has no register ioctl
+#endif
+}
+
+bool writePhyReg(esp_eth_handle_t handle, uint32_t reg, uint32_t value) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    esp_eth_phy_reg_rw_data_t rw = {reg, &value};
+    return handle && esp_eth_ioctl(handle, ETH_CMD_WRITE_PHY_REG, &rw) == ESP_OK;
+#else
+    return false;
+#endif
+}
+
+// Clause 22 access to a clause 45 register (IEEE 802.3 annex 22D)
+bool readMmd(esp_eth_handle_t handle, uint16_t devad, uint16_t reg, uint32_t& value) {
+    return writePhyReg(handle, PHY_REG_MMD_CTRL, devad) &&
+           writePhyReg(handle, PHY_REG_MMD_DATA, reg) &&
+           writePhyReg(handle, PHY_REG_MMD_CTRL, MMD_CTRL_DATA | devad) &&
+           readPhyReg(handle, PHY_REG_MMD_DATA, value);
+}
+
+bool writeMmd(esp_eth_handle_t handle, uint16_t devad, uint16_t reg, uint32_t value) {
+    return writePhyReg(handle, PHY_REG_MMD_CTRL, devad) &&
+           writePhyReg(handle, PHY_REG_MMD_DATA, reg) &&
+           writePhyReg(handle, PHY_REG_MMD_CTRL, MMD_CTRL_DATA | devad) &&
+           writePhyReg(handle, PHY_REG_MMD_DATA, value);
+}
+
+bool setRegBits(esp_eth_handle_t handle, uint32_t reg, uint32_t bits, bool set) {
+    uint32_t value = 0;
+    if (!readPhyReg(handle, reg, value)) return false;
+    uint32_t updated = set ? (value | bits) : (value & ~bits);
+    return updated == value || writePhyReg(handle, reg, updated);
+}
+
+}  // namespace
+
+void EthernetManager::setPhyPowerPolicy(bool eee, bool energyDetect) {
+    auto& inst = getInstance();
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for PHY power policy");
+            return;
+        }
+        inst.eeeEnabled = eee;
+        inst.energyDetectEnabled = energyDetect;
+    }
+
+    // A running driver gets the policy now; otherwise at ETHERNET_EVENT_START
+    if (inst.phyStarted && !inst.phyLowPower) {
+        inst.applyPhyPowerPolicy();
+    }
+    ETH_LOG_I("PHY power policy: EEE %s, energy detect %s", eee ? "on" : "off",
+              energyDetect ? "on" : "off");
+}
+
+void EthernetManager::applyPhyPowerPolicy() {
+    if (!ethHandle) return;
+
+    // Leave the PHY's reset defaults alone unless a policy is on, or was on
+    // and has to be undone once
+    if (!eeeEnabled && !energyDetectEnabled && !phyPowerPolicyApplied) return;
+    phyPowerPolicyApplied = eeeEnabled || energyDetectEnabled;
+
+    // Lost on every PHY reset or power cycle, so set on each start. Register
+    // 17 is vendor specific: EDPWRDOWN only exists on the LAN87xx parts
+    uint32_t id1 = 0, id2 = 0;
+    bool lan87xx = readPhyReg(ethHandle, PHY_REG_ID1, id1) && readPhyReg(ethHandle, PHY_REG_ID2, id2) &&
+                   strncmp(identifyPhy((uint16_t)id1, (uint16_t)id2), "LAN87", 5) == 0;
+    bool armed = false;
+    if (lan87xx && setRegBits(ethHandle, PHY_REG_LAN87XX_MCSR, MCSR_EDPWRDOWN, energyDetectEnabled)) {
+        armed = energyDetectEnabled;
+    } else if (energyDetectEnabled) {
+        ETH_LOG_W("Energy-detect power-down unavailable (%s)",
+                  lan87xx ? "no PHY register access" : "not a LAN87xx PHY");
+    }
+
+    // PHYs without clause 45 EEE read zero through the MMD window
+    uint32_t capability = 0, advert = 0, partner = 0;
+    bool capable = readMmd(ethHandle, MMD_PCS, MMD_PCS_EEE_CAPABILITY, capability) &&
+                   (capability & EEE_100BASE_TX);
+    bool advertised = false;
+    if (capable && readMmd(ethHandle, MMD_AN, MMD_AN_EEE_ADVERTISEMENT, advert)) {
+        advertised = (advert & EEE_100BASE_TX) != 0;
+        if (advertised != eeeEnabled) {
+            // The partner only sees the new advertisement after renegotiating
+            uint32_t updated = eeeEnabled ? (advert | EEE_100BASE_TX) : (advert & ~EEE_100BASE_TX);
+            if (writeMmd(ethHandle, MMD_AN, MMD_AN_EEE_ADVERTISEMENT, updated) &&
+                setRegBits(ethHandle, PHY_REG_BMCR, BMCR_AUTONEG_RESTART, true)) {
+                advertised = eeeEnabled;
+            }
+        }
+        if (readMmd(ethHandle, MMD_AN, MMD_AN_EEE_PARTNER, partner)) {
+            partner &= EEE_100BASE_TX;
+        }
+    } else if (eeeEnabled) {
+        ETH_LOG_D("PHY has no 100BASE-TX EEE capability");
+    }
+
+    powerStats.energyDetect = armed;
+    powerStats.eeeCapable = capable;
+    powerStats.eeeAdvertised = advertised;
+    powerStats.eeePartner = partner != 0;
+    accountPowerState(powerStats.state == EthPhyPowerState::ACTIVE);
+}
+
+bool EthernetManager::setPhyLowPower(bool enable) {
+    auto& inst = getInstance();
+    if (!inst.phyStarted || !inst.ethHandle) {
+        ETH_LOG_E("PHY low power needs a started driver");
+        inst.lastError = EthError::NOT_INITIALIZED;
+        return false;
+    }
+    if (enable == inst.phyLowPower) return true;
+    if (enable && inst.wolArmed) {
+        ETH_LOG_E("PHY must stay powered while suspended for Wake-on-LAN");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    if (enable) {
+        // Set first so the STOP event skips the hold and reconnect paths
+        inst.phyLowPower = true;
+        esp_eth_stop(inst.ethHandle);
+
+        bool off = true;
+        if (inst.beginPowerPin >= 0) {
+            inst.drivePhyPower(false);
+        } else {
+            off = setRegBits(inst.ethHandle, PHY_REG_BMCR, BMCR_POWER_DOWN, true);
+        }
+        if (!off) {
+            ETH_LOG_E("PHY power-down failed (no power pin or register access)");
+            inst.phyLowPower = false;
+            esp_eth_start(inst.ethHandle);
+            inst.lastError = EthError::CONFIG_FAILED;
+            return false;
+        }
+
+        inst.powerStats.lowPowerEntries++;
+        inst.accountPowerState(false);
+        ETH_LOG_I("PHY powered down (%s)", inst.beginPowerPin >= 0 ? "power pin" : "BMCR");
+        return true;
+    }
+
+    if (inst.beginPowerPin >= 0) {
+        inst.drivePhyPower(true);
+        vTaskDelay(pdMS_TO_TICKS(ETH_PHY_POWER_ON_SETTLE_MS));
+    } else {
+        setRegBits(inst.ethHandle, PHY_REG_BMCR, BMCR_POWER_DOWN, false);
+    }
+    inst.phyLowPower = false;
+    inst.accountPowerState(false);
+
+    // Start restarts autonegotiation; ETHERNET_EVENT_START reapplies the policy
+    esp_err_t err = esp_eth_start(inst.ethHandle);
+    if (err != ESP_OK) {
+        ETH_LOG_E("Driver restart after PHY power-down failed: %d", err);
+        inst.lastError = EthError::PHY_START_FAILED;
+        return false;
+    }
+    ETH_LOG_I("PHY powered up");
+    return true;
+}
+
+void EthernetManager::accountPowerState(bool linkUp) {
+    uint32_t now = millis();
+    if (powerAccounting) {
+        uint32_t elapsed = now - powerStateSince;
+        switch (powerStats.state) {
+            case EthPhyPowerState::ACTIVE: powerStats.activeMs += elapsed; break;
+            case EthPhyPowerState::ENERGY_DETECT: powerStats.energyDetectMs += elapsed; break;
+            case EthPhyPowerState::POWER_DOWN: powerStats.powerDownMs += elapsed; break;
+            case EthPhyPowerState::NO_LINK:
+            default: powerStats.noLinkMs += elapsed; break;
+        }
+    }
+    powerStateSince = now;
+    powerAccounting = phyStarted;
+
+    powerStats.state = phyLowPower ? EthPhyPowerState::POWER_DOWN :
+                       linkUp ? EthPhyPowerState::ACTIVE :
+                       powerStats.energyDetect ? EthPhyPowerState::ENERGY_DETECT :
+                       EthPhyPowerState::NO_LINK;
+}
+
+EthPowerStats EthernetManager::getPowerStats() {
+    auto& inst = getInstance();
+    EthPowerStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.accountPowerState(inst.powerStats.state == EthPhyPowerState::ACTIVE);
+        currentStats = inst.powerStats;
+    }
+    return currentStats;
+}
+
+const char* EthernetManager::powerStateToString(EthPhyPowerState state) {
+    switch (state) {
+        case EthPhyPowerState::ACTIVE: return "ACTIVE";
+        case EthPhyPowerState::NO_LINK: return "NO_LINK";
+        case EthPhyPowerState::ENERGY_DETECT: return "ENERGY_DETECT";
+        case EthPhyPowerState::POWER_DOWN: return "POWER_DOWN";
+        default: return "UNKNOWN";
+    }
+}
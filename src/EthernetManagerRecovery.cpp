@@ -0,0 +1,367 @@
+// EthernetManagerRecovery.cpp
+// Reconnect escalation ladder and backoff policies
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <driver/gpio.h>
+#include <esp_eth.h>
+#include <esp_netif.h>
+
+// Escalation order; each step gets ETH_RECOVERY_ATTEMPTS_PER_STEP attempts
+static const EthRecoveryAction RECOVERY_LADDER[] = {
+    EthRecoveryAction::DHCP_RESTART,
+    EthRecoveryAction::DRIVER_RESTART,
+    EthRecoveryAction::PHY_POWER_CYCLE,
+    EthRecoveryAction::NETIF_RECREATE,
+};
+static constexpr size_t RECOVERY_STEPS = sizeof(RECOVERY_LADDER) / sizeof(RECOVERY_LADDER[0]);
+static_assert(ETH_RECOVERY_ATTEMPTS_PER_STEP > 0, "ETH_RECOVERY_ATTEMPTS_PER_STEP must be at least 1");
+
+void EthernetManager::setReconnectBackoff(EthBackoffPolicy policy) {
+    auto& inst = getInstance();
+    if (policy == EthBackoffPolicy::CUSTOM && !inst.backoffFunction) {
+        ETH_LOG_E("CUSTOM backoff requires a backoff function");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return;
+    }
+
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.backoffPolicy = policy;
+    }
+}
+
+void EthernetManager::setReconnectBackoff(EthBackoffFunction fn) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.backoffFunction = fn;
+        inst.backoffPolicy = fn ? EthBackoffPolicy::CUSTOM : EthBackoffPolicy::EXPONENTIAL;
+    }
+}
+
+const char* EthernetManager::recoveryActionToString(EthRecoveryAction action) {
+    switch (action) {
+        case EthRecoveryAction::NONE: return "NONE";
+        case EthRecoveryAction::DHCP_RESTART: return "DHCP_RESTART";
+        case EthRecoveryAction::DRIVER_RESTART: return "DRIVER_RESTART";
+        case EthRecoveryAction::PHY_POWER_CYCLE: return "PHY_POWER_CYCLE";
+        case EthRecoveryAction::NETIF_RECREATE: return "NETIF_RECREATE";
+        default: return "UNKNOWN";
+    }
+}
+
+uint32_t EthernetManager::backoffRandom(uint32_t lo, uint32_t hi) {
+    if (backoffRng == 0) {
+        // FNV-1a over the MAC: devices sharing a power feed still diverge
+        uint8_t mac[ETH_MAC_ADDRESS_SIZE] = {0};
+        if (eth_netif) {
+            esp_netif_get_mac(eth_netif, mac);
+        }
+        uint32_t h = 2166136261u;
+        for (uint8_t b : mac) {
+            h = (h ^ b) * 16777619u;
+        }
+        backoffRng = h ? h : 0x9E3779B9u;
+    }
+
+    // xorshift32
+    backoffRng ^= backoffRng << 13;
+    backoffRng ^= backoffRng >> 17;
+    backoffRng ^= backoffRng << 5;
+
+    if (hi <= lo) return lo;
+    return lo + backoffRng % (hi - lo + 1);
+}
+
+uint32_t EthernetManager::nextBackoffDelay() {
+    uint32_t prev = reconnectCurrentDelay;
+    uint32_t delay;
+
+    switch (backoffPolicy) {
+        case EthBackoffPolicy::EXPONENTIAL:
+            delay = (reconnectAttempts == 0 || prev == 0) ? reconnectInitialDelay : prev * 2;
+            break;
+
+        case EthBackoffPolicy::FULL_JITTER: {
+            // Exponential ceiling for this attempt, then uniform below it
+            uint8_t shift = reconnectAttempts < 16 ? reconnectAttempts : 16;
+            uint64_t ceiling = (uint64_t)reconnectInitialDelay << shift;
+            delay = backoffRandom(0, ceiling < reconnectMaxDelay ? (uint32_t)ceiling : reconnectMaxDelay);
+            break;
+        }
+
+        case EthBackoffPolicy::CUSTOM:
+            delay = backoffFunction ? backoffFunction(reconnectAttempts + 1, prev) : reconnectInitialDelay;
+            break;
+
+        case EthBackoffPolicy::DECORRELATED_JITTER:
+        default: {
+            uint64_t upper = (uint64_t)(prev > reconnectInitialDelay ? prev : reconnectInitialDelay) * 3;
+            delay = backoffRandom(reconnectInitialDelay,
+                                  upper < reconnectMaxDelay ? (uint32_t)upper : reconnectMaxDelay);
+            break;
+        }
+    }
+
+    if (delay > reconnectMaxDelay) delay = reconnectMaxDelay;
+    return delay > 0 ? delay : 1;
+}
+
+void EthernetManager::scheduleReconnect() {
+    if (!reconnectTimer) return;
+
+    reconnectCurrentDelay = nextBackoffDelay();
+    ETH_LOG_D("Next reconnect attempt in %u ms", reconnectCurrentDelay);
+
+    // xTimerChangePeriod also starts a dormant timer
+    xTimerChangePeriod(reconnectTimer, pdMS_TO_TICKS(reconnectCurrentDelay), 0);
+}
+
+EthRecoveryAction EthernetManager::nextRecoveryAction() {
+    if (!phyStarted || reconnectAttempts == 0) return EthRecoveryAction::NONE;
+    return recoveryActionForStep((reconnectAttempts - 1) / ETH_RECOVERY_ATTEMPTS_PER_STEP);
+}
+
+EthRecoveryAction EthernetManager::recoveryActionForStep(size_t step) {
+    if (step >= RECOVERY_STEPS) step = RECOVERY_STEPS - 1;
+    EthRecoveryAction action = RECOVERY_LADDER[step];
+
+    bool linkUp = EthBackend::linkUp();
+    if (!linkUp) {
+        // No carrier: DHCP cannot help and a new netif will not bring a cable back
+        if (action == EthRecoveryAction::DHCP_RESTART) action = EthRecoveryAction::DRIVER_RESTART;
+        if (action == EthRecoveryAction::NETIF_RECREATE) action = EthRecoveryAction::PHY_POWER_CYCLE;
+    }
+
+    if (action == EthRecoveryAction::PHY_POWER_CYCLE && beginPowerPin < 0) {
+        action = linkUp ? EthRecoveryAction::NETIF_RECREATE : EthRecoveryAction::DRIVER_RESTART;
+    }
+
+    if (action == EthRecoveryAction::DHCP_RESTART && staticIpMode) {
+        action = EthRecoveryAction::DRIVER_RESTART;
+    }
+
+    return action;
+}
+
+void EthernetManager::startRecovery(EthRecoveryAction action) {
+    MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) return;
+
+    // No event group means cleanup() has torn the manager down
+    lastRecoveryAction = action;
+    if (action == EthRecoveryAction::NONE || recoveryTask || phyLowPower || wolArmed || !ethEventGroup) return;
+
+    // Driver calls block (a power cycle waits on the PHY); keep them off the timer task
+    pendingRecovery = action;
+    xEventGroupClearBits(ethEventGroup, BIT_RECOVERY_DONE);
+    if (xTaskCreate(recoveryTaskFunc, "EthRecovery", ETH_RECOVERY_TASK_STACK, nullptr,
+                    tskIDLE_PRIORITY + 2, &recoveryTask) != pdPASS) {
+        ETH_LOG_E("Failed to create recovery task");
+        recoveryTask = nullptr;
+        xEventGroupSetBits(ethEventGroup, BIT_RECOVERY_DONE);
+    }
+}
+
+void EthernetManager::stopRecovery() {
+    // Nothing new starts from the timers; a running action is let finish
+    if (reconnectTimer) {
+        xTimerStop(reconnectTimer, 0);
+    }
+    if (dhcpWatchdogTimer) {
+        xTimerStop(dhcpWatchdogTimer, 0);
+    }
+    if (recoveryTask && ethEventGroup) {
+        EventBits_t bits = xEventGroupWaitBits(ethEventGroup, BIT_RECOVERY_DONE, pdFALSE, pdFALSE,
+                                               pdMS_TO_TICKS(ETH_INIT_TIMEOUT_MS));
+        if (!(bits & BIT_RECOVERY_DONE)) {
+            ETH_LOG_W("Recovery task still running");
+        }
+    }
+}
+
+void EthernetManager::setDhcpWatchdog(uint32_t timeoutMs) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for DHCP watchdog");
+        return;
+    }
+
+    inst.dhcpWatchdogTimeout = timeoutMs;
+    if (timeoutMs == 0) {
+        if (inst.dhcpWatchdogTimer) {
+            xTimerStop(inst.dhcpWatchdogTimer, 0);
+        }
+        return;
+    }
+
+    // Re-arm with the new timeout if already waiting for an address
+    if (inst.connectionState == EthConnectionState::OBTAINING_IP) {
+        inst.handleDhcpWatchdogStateChange(EthConnectionState::OBTAINING_IP);
+    }
+}
+
+void EthernetManager::handleDhcpWatchdogStateChange(EthConnectionState newState) {
+    if (newState == EthConnectionState::CONNECTED) {
+        dhcpWatchdogLevel = 0;
+    }
+
+    if (newState != EthConnectionState::OBTAINING_IP || dhcpWatchdogTimeout == 0) {
+        if (dhcpWatchdogTimer) {
+            xTimerStop(dhcpWatchdogTimer, 0);
+        }
+        return;
+    }
+
+    if (!dhcpWatchdogTimer) {
+        dhcpWatchdogTimer = xTimerCreate("EthDhcpWdt", pdMS_TO_TICKS(dhcpWatchdogTimeout), pdFALSE,
+                                         nullptr, dhcpWatchdogCallback);
+        if (!dhcpWatchdogTimer) {
+            ETH_LOG_E("Failed to create DHCP watchdog timer");
+            return;
+        }
+    }
+    xTimerChangePeriod(dhcpWatchdogTimer, pdMS_TO_TICKS(dhcpWatchdogTimeout), 0);
+}
+
+void EthernetManager::dhcpWatchdogCallback(TimerHandle_t xTimer) {
+    auto& inst = getInstance();
+    if (inst.connectionState != EthConnectionState::OBTAINING_IP) return;
+
+    // First expiry restarts DHCP; each further one climbs the recovery ladder
+    EthRecoveryAction action = inst.recoveryActionForStep(inst.dhcpWatchdogLevel);
+    if (inst.dhcpWatchdogLevel < RECOVERY_STEPS - 1) {
+        inst.dhcpWatchdogLevel++;
+    }
+    inst.stats.dhcpWatchdogTrips++;
+
+    ETH_LOG_W("Stuck in OBTAINING_IP for %u ms - %s", inst.dhcpWatchdogTimeout,
+              recoveryActionToString(action));
+    inst.startRecovery(action);
+
+    xTimerStart(xTimer, 0);
+}
+
+bool EthernetManager::runRecoveryAction(EthRecoveryAction action) {
+    esp_err_t err = ESP_OK;
+
+    switch (action) {
+        case EthRecoveryAction::DHCP_RESTART:
+            if (!eth_netif) return false;
+            stats.dhcpRestarts++;
+            esp_netif_dhcpc_stop(eth_netif);
+            err = esp_netif_dhcpc_start(eth_netif);
+            break;
+
+        case EthRecoveryAction::DRIVER_RESTART:
+            if (!ethHandle) return false;
+            stats.driverRestarts++;
+            esp_eth_stop(ethHandle);
+            err = esp_eth_start(ethHandle);
+            break;
+
+        case EthRecoveryAction::PHY_POWER_CYCLE:
+            if (!ethHandle || beginPowerPin < 0) return false;
+            stats.phyPowerCycles++;
+            esp_eth_stop(ethHandle);
+            drivePhyPower(false);
+            vTaskDelay(pdMS_TO_TICKS(ETH_PHY_POWER_OFF_MS));
+            drivePhyPower(true);
+            vTaskDelay(pdMS_TO_TICKS(ETH_PHY_POWER_ON_SETTLE_MS));
+            err = esp_eth_start(ethHandle);
+            break;
+
+        case EthRecoveryAction::NETIF_RECREATE:
+            stats.netifRecreates++;
+            return recreateInterface();
+
+        case EthRecoveryAction::NONE:
+        default:
+            return true;
+    }
+
+    if (err != ESP_OK && err != ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED) {
+        ETH_LOG_E("Recovery %s failed: %d", recoveryActionToString(action), err);
+        return false;
+    }
+    return true;
+}
+
+void EthernetManager::drivePhyPower(bool on) {
+    // Not digitalWrite(): Arduino 3.x gives the pin to ETH and the native
+    // backend never calls pinMode(), so the Arduino layer refuses the write
+    gpio_num_t pin = (gpio_num_t)beginPowerPin;
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(pin, on ? 1 : 0);
+}
+
+bool EthernetManager::recreateInterface() {
+    if (EthBackend::canRecreate()) {
+        bool started = false;
+        {
+            // Held across end()/begin() as in internalInit(), so the API and
+            // cleanup() never see a half-built driver
+            MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_INIT_TIMEOUT_MS));
+            if (!guard) {
+                ETH_LOG_E("Failed to take mutex for interface recreate");
+                return false;
+            }
+            if (!phyStarted) return false;  // cleanup() got here first
+
+            // end() destroys driver, glue and netif; begin() builds fresh ones
+            EthBackend::end();
+            eth_netif = nullptr;
+            ethHandle = nullptr;
+
+            started = EthBackend::begin(backendConfig());
+            if (started) {
+                eth_netif = EthBackend::netif();
+                netifCreated = eth_netif != nullptr;
+            } else {
+                phyStarted = false;
+                lastError = EthError::PHY_START_FAILED;
+            }
+        }
+
+        // State change callbacks run outside the mutex
+        if (!started) {
+            ETH_LOG_E("Interface recreate: %s start failed", EthBackend::NAME);
+            changeState(EthConnectionState::ERROR_STATE);
+            return false;
+        }
+        ETH_LOG_W("Interface recreated");
+        return netifCreated;
+    }
+
+    // Arduino 2.x cannot tear ETH down; restart the driver and the DHCP client
+    if (!ethHandle) return false;
+    esp_eth_stop(ethHandle);
+    esp_err_t err = esp_eth_start(ethHandle);
+    if (eth_netif && !staticIpMode) {
+        esp_netif_dhcpc_stop(eth_netif);
+        esp_netif_dhcpc_start(eth_netif);
+    }
+    ETH_LOG_W("Interface recreate unavailable on Arduino 2.x, restarted driver");
+    return err == ESP_OK;
+}
+
+void EthernetManager::recoveryTaskFunc(void* param) {
+    auto& inst = getInstance();
+    EthRecoveryAction action = inst.pendingRecovery;
+
+    if (!isConnected() && !inst.runRecoveryAction(action)) {
+        inst.lastError = EthError::CONFIG_FAILED;
+    }
+
+    // Cleared under the lock startRecovery() checks it with; cleanup() waits for the bit
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        inst.recoveryTask = nullptr;
+        if (inst.ethEventGroup) {
+            xEventGroupSetBits(inst.ethEventGroup, BIT_RECOVERY_DONE);
+        }
+    }
+    vTaskDelete(nullptr);
+}
@@ -0,0 +1,472 @@
+// EthernetManagerShaper.cpp
+// Traffic shaper: DSCP/port/EtherType classes with token-bucket limits, egress
+// queues served in strict priority from the lwIP core, and ingress policing.
+// Its linkoutput hook is the shared egress path, which also adds the 802.1Q tag
+#include "EthernetManager.h"
+#include "EthernetManagerTokenBucket.h"
+#include "MutexGuard.h"
+
+#include <esp_timer.h>
+
+#include <lwip/netif.h>
+#include <lwip/pbuf.h>
+#include <lwip/tcpip.h>
+#include <lwip/timeouts.h>
+
+static constexpr uint32_t ETH_HEADER_LEN = 14;
+static constexpr uint32_t ETH_MAX_FRAME = 1518;
+static constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+static constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+static constexpr uint16_t ETHERTYPE_ARP = 0x0806;
+static constexpr uint8_t IP_PROTO_TCP = 6;
+static constexpr uint8_t IP_PROTO_UDP = 17;
+static constexpr uint8_t DSCP_CS6 = 48;
+
+namespace {
+
+// Driver output the hook forwards to, and the netif it was taken from
+netif_linkoutput_fn driverLinkOutput = nullptr;
+struct netif* shapedNetif = nullptr;
+bool serviceScheduled = false;
+
+// The netif may have been destroyed by a recreate since the frame was queued
+bool netifAlive(struct netif* nif) {
+    struct netif* it;
+    NETIF_FOREACH(it) {
+        if (it == nif) return true;
+    }
+    return false;
+}
+
+// Ingress buckets are read by the EMAC receive task; this lock covers the
+// few instructions a frame spends on them and a reconfiguration
+portMUX_TYPE ingressLock = portMUX_INITIALIZER_UNLOCKED;
+
+struct ShaperCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+};
+
+// Egress rate change, applied where the buckets are used
+struct RateCall {
+    struct tcpip_api_call_data call;
+    int8_t cls;                        // -1 = link bucket
+    uint32_t kbps;
+    uint32_t burstBytes;
+};
+
+template <typename Bucket>
+void configure(Bucket& bucket, uint32_t kbps, uint32_t burstBytes) {
+    bucket.bytesPerSec = kbps * 125;
+    bucket.burst = burstBytes < ETH_MAX_FRAME ? ETH_MAX_FRAME : burstBytes;
+    bucket.tokens = bucket.burst;
+    bucket.refilledUs = esp_timer_get_time();
+}
+
+}  // namespace
+
+// Runs in the lwIP core (tcpip thread or with the core lock held)
+struct TrafficShaperHooks {
+    // Last step before the driver: the Ethernet interface's VLAN tag
+    static err_t output(struct netif* nif, struct pbuf* p) {
+        auto& inst = EthernetManager::getInstance();
+        if (inst.vlanId == 0) {
+            return driverLinkOutput(nif, p);
+        }
+
+        struct pbuf* tagged = inst.vlanTag(p);
+        if (!tagged) {
+            inst.vlanStats.txErrors++;
+            return ERR_MEM;
+        }
+        err_t err = driverLinkOutput(nif, tagged);
+        pbuf_free(tagged);
+        if (err == ERR_OK) {
+            inst.vlanStats.txFrames++;
+            inst.vlanStats.txBytes += p->tot_len;
+        } else {
+            inst.vlanStats.txErrors++;
+        }
+        return err;
+    }
+
+    static err_t linkOutput(struct netif* nif, struct pbuf* p) {
+        auto& inst = EthernetManager::getInstance();
+        if (!inst.shaperEnabled) {
+            return output(nif, p);
+        }
+
+        auto cls = (uint8_t)inst.classifyTraffic(static_cast<const uint8_t*>(p->payload), p->len);
+        auto& c = inst.shaperClasses[cls];
+        int64_t now = esp_timer_get_time();
+
+        // Stay in order within the class; on a limited link also behind higher classes
+        bool behind = c.count > 0;
+        for (uint8_t i = 0; i < cls && inst.shaperLink.bytesPerSec; i++) {
+            behind |= inst.shaperClasses[i].count > 0;
+        }
+
+        TokenBucket::refill(c.egress, now);
+        TokenBucket::refill(inst.shaperLink, now);
+        if (!behind && TokenBucket::hasTokens(c.egress, p->tot_len) &&
+            TokenBucket::hasTokens(inst.shaperLink, p->tot_len)) {
+            TokenBucket::consume(c.egress, p->tot_len);
+            TokenBucket::consume(inst.shaperLink, p->tot_len);
+            c.stats.txFrames++;
+            c.stats.txBytes += p->tot_len;
+            return output(nif, p);
+        }
+
+        if (c.count >= ETH_SHAPER_QUEUE_DEPTH) {
+            c.stats.txDropped++;
+            return ERR_MEM;
+        }
+
+        pbuf_ref(p);
+        auto& entry = c.queue[(c.head + c.count) % ETH_SHAPER_QUEUE_DEPTH];
+        entry.p = p;
+        entry.enqueuedUs = now;
+        c.count++;
+        c.stats.txDelayed++;
+        schedule(0);
+        return ERR_OK;
+    }
+
+    static void schedule(uint32_t delayUs) {
+        if (serviceScheduled) return;
+        serviceScheduled = true;
+        uint32_t ms = (delayUs + 999) / 1000;
+        sys_timeout(ms ? ms : 1, service, nullptr);
+    }
+
+    static void send(EthernetManager::ShaperClass& c, int64_t now) {
+        auto& entry = c.queue[c.head];
+        struct pbuf* p = entry.p;
+        c.head = (c.head + 1) % ETH_SHAPER_QUEUE_DEPTH;
+        c.count--;
+
+        uint32_t delay = (uint32_t)(now - entry.enqueuedUs);
+        c.delayTotalUs += delay;
+        if (delay > c.stats.txDelayMaxUs) c.stats.txDelayMaxUs = delay;
+        c.stats.txFrames++;
+        c.stats.txBytes += p->tot_len;
+
+        if (shapedNetif && driverLinkOutput && netifAlive(shapedNetif)) {
+            output(shapedNetif, p);
+        }
+        pbuf_free(p);
+    }
+
+    static void service(void* arg) {
+        auto& inst = EthernetManager::getInstance();
+        serviceScheduled = false;
+        int64_t now = esp_timer_get_time();
+        TokenBucket::refill(inst.shaperLink, now);
+
+        // Strict priority: restart from the top after every frame. A class
+        // waiting on its own bucket lets lower classes through; one waiting
+        // on the link stops everything below it.
+        uint32_t nextUs = UINT32_MAX;
+        bool sent = true;
+        while (sent) {
+            sent = false;
+            nextUs = UINT32_MAX;
+            for (uint8_t i = 0; i < EthernetManager::TRAFFIC_CLASSES; i++) {
+                auto& c = inst.shaperClasses[i];
+                if (c.count == 0) continue;
+
+                uint32_t bytes = c.queue[c.head].p->tot_len;
+                TokenBucket::refill(c.egress, now);
+                uint32_t classWait = TokenBucket::waitUs(c.egress, bytes);
+                uint32_t linkWait = TokenBucket::waitUs(inst.shaperLink, bytes);
+                if (classWait == 0 && linkWait == 0) {
+                    TokenBucket::consume(c.egress, bytes);
+                    TokenBucket::consume(inst.shaperLink, bytes);
+                    send(c, now);
+                    sent = true;
+                    break;
+                }
+                uint32_t wait = classWait > linkWait ? classWait : linkWait;
+                if (wait < nextUs) nextUs = wait;
+                if (linkWait > 0) break;
+            }
+        }
+
+        if (nextUs != UINT32_MAX) {
+            schedule(nextUs);
+        }
+    }
+
+    // Send everything queued, e.g. when the shaper is turned off
+    static void drain() {
+        auto& inst = EthernetManager::getInstance();
+        int64_t now = esp_timer_get_time();
+        for (uint8_t i = 0; i < EthernetManager::TRAFFIC_CLASSES; i++) {
+            while (inst.shaperClasses[i].count > 0) {
+                send(inst.shaperClasses[i], now);
+            }
+        }
+    }
+
+    static err_t attachInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<ShaperCall*>(call);
+
+        // netif_add() on every driver start puts the driver output back
+        if (msg->nif->linkoutput != linkOutput) {
+            drain();  // Goes nowhere if the old netif is gone
+            driverLinkOutput = msg->nif->linkoutput;
+            msg->nif->linkoutput = linkOutput;
+        }
+        shapedNetif = msg->nif;
+        return ERR_OK;
+    }
+
+    static err_t drainInTcpip(struct tcpip_api_call_data* call) {
+        if (driverLinkOutput) {
+            drain();
+        }
+        return ERR_OK;
+    }
+
+    static err_t rateInTcpip(struct tcpip_api_call_data* call) {
+        auto* msg = reinterpret_cast<RateCall*>(call);
+        auto& inst = EthernetManager::getInstance();
+        configure(msg->cls < 0 ? inst.shaperLink : inst.shaperClasses[msg->cls].egress,
+                  msg->kbps, msg->burstBytes);
+        return ERR_OK;
+    }
+
+    // cleanup(): the driver output goes back on the netif and queued frames are dropped
+    static err_t detachInTcpip(struct tcpip_api_call_data* call) {
+        auto& inst = EthernetManager::getInstance();
+        if (serviceScheduled) {
+            sys_untimeout(service, nullptr);
+            serviceScheduled = false;
+        }
+        if (shapedNetif && driverLinkOutput && netifAlive(shapedNetif) &&
+            shapedNetif->linkoutput == linkOutput) {
+            shapedNetif->linkoutput = driverLinkOutput;
+        }
+        for (uint8_t i = 0; i < EthernetManager::TRAFFIC_CLASSES; i++) {
+            auto& c = inst.shaperClasses[i];
+            while (c.count > 0) {
+                pbuf_free(c.queue[c.head].p);
+                c.head = (c.head + 1) % ETH_SHAPER_QUEUE_DEPTH;
+                c.count--;
+            }
+        }
+        driverLinkOutput = nullptr;
+        shapedNetif = nullptr;
+        return ERR_OK;
+    }
+
+    // Without a netif the hook is not installed and nothing reads the buckets
+    static void apply(RateCall& msg) {
+        if (EthBackend::netif()) {
+            tcpip_api_call(rateInTcpip, &msg.call);
+        } else {
+            rateInTcpip(&msg.call);
+        }
+    }
+};
+
+bool EthernetManager::egressHookNeeded() const {
+    return shaperEnabled || vlanId != 0;
+}
+
+void EthernetManager::detachEgressHook() {
+    if (!driverLinkOutput) return;
+    ShaperCall msg = {};
+    tcpip_api_call(TrafficShaperHooks::detachInTcpip, &msg.call);
+}
+
+void EthernetManager::attachEgressHook() {
+    // Not eth_netif: after a recreate it is only updated once the backend is up
+    esp_netif_t* netif = EthBackend::netif();
+    ShaperCall msg = {};
+    msg.nif = netif ? static_cast<struct netif*>(esp_netif_get_netif_impl(netif)) : nullptr;
+    if (!msg.nif) return;
+    tcpip_api_call(TrafficShaperHooks::attachInTcpip, &msg.call);
+}
+
+EthTrafficClass EthernetManager::classifyTraffic(const uint8_t* frame, uint32_t length) {
+    if (length < ETH_HEADER_LEN) return EthTrafficClass::NORMAL;
+
+    uint16_t etherType = ((uint16_t)frame[12] << 8) | frame[13];
+    const uint8_t* ip = frame + ETH_HEADER_LEN;
+    uint32_t ipLength = length - ETH_HEADER_LEN;
+
+    bool hasDscp = false, hasPorts = false;
+    uint8_t dscp = 0;
+    const uint8_t* l4 = nullptr;
+    if (etherType == ETHERTYPE_IPV4 && ipLength >= 20) {
+        hasDscp = true;
+        dscp = ip[1] >> 2;
+        uint32_t headerLength = (ip[0] & 0x0F) * 4;
+        bool firstFragment = ((ip[6] & 0x1F) | ip[7]) == 0;
+        if (firstFragment && (ip[9] == IP_PROTO_TCP || ip[9] == IP_PROTO_UDP) && ipLength >= headerLength + 4) {
+            l4 = ip + headerLength;
+        }
+    } else if (etherType == ETHERTYPE_IPV6 && ipLength >= 40) {
+        hasDscp = true;
+        dscp = ((ip[0] & 0x0F) << 2) | (ip[1] >> 6);
+        // Extension headers are not walked
+        if ((ip[6] == IP_PROTO_TCP || ip[6] == IP_PROTO_UDP) && ipLength >= 44) {
+            l4 = ip + 40;
+        }
+    }
+    uint16_t srcPort = 0, dstPort = 0;
+    if (l4) {
+        hasPorts = true;
+        srcPort = ((uint16_t)l4[0] << 8) | l4[1];
+        dstPort = ((uint16_t)l4[2] << 8) | l4[3];
+    }
+
+    uint8_t count = shaperRuleCount;
+    for (uint8_t i = 0; i < count; i++) {
+        const ShaperRule& rule = shaperRules[i];
+        bool match = false;
+        switch (rule.match) {
+            case EthTrafficMatch::DSCP: match = hasDscp && dscp == rule.value; break;
+            case EthTrafficMatch::PORT: match = hasPorts && (srcPort == rule.value || dstPort == rule.value); break;
+            case EthTrafficMatch::ETHERTYPE: match = etherType == rule.value; break;
+        }
+        if (match) return rule.cls;
+    }
+
+    // Address resolution and network control (CS6/CS7) must not starve
+    if (etherType == ETHERTYPE_ARP || (hasDscp && dscp >= DSCP_CS6)) {
+        return EthTrafficClass::CONTROL;
+    }
+    return EthTrafficClass::NORMAL;
+}
+
+bool EthernetManager::policeIngress(const uint8_t* frame, uint32_t length) {
+    auto& c = shaperClasses[(uint8_t)classifyTraffic(frame, length)];
+    c.stats.rxFrames++;
+    if (c.ingress.bytesPerSec == 0) return false;
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&ingressLock);
+    TokenBucket::refill(c.ingress, now);
+    bool pass = TokenBucket::hasTokens(c.ingress, length);
+    if (pass) {
+        TokenBucket::consume(c.ingress, length);
+    }
+    portEXIT_CRITICAL(&ingressLock);
+
+    if (!pass) {
+        c.stats.rxDropped++;
+    }
+    return !pass;
+}
+
+void EthernetManager::setTrafficShaper(bool enable) {
+    auto& inst = getInstance();
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for traffic shaper");
+            return;
+        }
+        inst.shaperEnabled = enable;
+    }
+
+    // Hook work goes through the tcpip thread, outside the mutex
+
+    if (enable) {
+        // Without a netif the hooks go in at driver start and link up
+        if (inst.ethHandle) {
+            inst.installStackInput();
+        }
+        inst.attachEgressHook();
+    } else if (inst.eth_netif) {
+        ShaperCall msg = {};
+        tcpip_api_call(TrafficShaperHooks::drainInTcpip, &msg.call);
+    }
+    ETH_LOG_I("Traffic shaper %s", enable ? "enabled" : "disabled");
+}
+
+void EthernetManager::setTrafficClassRate(EthTrafficClass cls, uint32_t egressKbps, uint32_t ingressKbps,
+                                          uint32_t burstBytes) {
+    auto& inst = getInstance();
+    if ((uint8_t)cls >= TRAFFIC_CLASSES) {
+        return;
+    }
+
+    // Each bucket is rewritten by, or under the lock of, the context that uses it
+    RateCall msg = {};
+    msg.cls = (int8_t)cls;
+    msg.kbps = egressKbps;
+    msg.burstBytes = burstBytes;
+    TrafficShaperHooks::apply(msg);
+
+    portENTER_CRITICAL(&ingressLock);
+    configure(inst.shaperClasses[(uint8_t)cls].ingress, ingressKbps, burstBytes);
+    portEXIT_CRITICAL(&ingressLock);
+}
+
+void EthernetManager::setShaperLinkRate(uint32_t kbps, uint32_t burstBytes) {
+    RateCall msg = {};
+    msg.cls = -1;
+    msg.kbps = kbps;
+    msg.burstBytes = burstBytes;
+    TrafficShaperHooks::apply(msg);
+}
+
+bool EthernetManager::addTrafficRule(EthTrafficMatch match, uint16_t value, EthTrafficClass cls) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        return false;
+    }
+
+    if (inst.shaperRuleCount >= ETH_MAX_TRAFFIC_RULES || (uint8_t)cls >= TRAFFIC_CLASSES) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+
+    // Filled in before the count makes it visible to the classifier
+    ShaperRule& rule = inst.shaperRules[inst.shaperRuleCount];
+    rule.match = match;
+    rule.value = value;
+    rule.cls = cls;
+    inst.shaperRuleCount = inst.shaperRuleCount + 1;
+    return true;
+}
+
+void EthernetManager::clearTrafficRules() {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.shaperRuleCount = 0;
+    }
+}
+
+TrafficClassStats EthernetManager::getTrafficClassStats(EthTrafficClass cls) {
+    auto& inst = getInstance();
+    TrafficClassStats currentStats = {};
+    if ((uint8_t)cls >= TRAFFIC_CLASSES) {
+        return currentStats;
+    }
+
+    // Counters are single words written by one task each
+    const auto& c = inst.shaperClasses[(uint8_t)cls];
+    currentStats = c.stats;
+    currentStats.queued = c.count;
+    uint32_t dequeued = currentStats.txDelayed - c.count;
+    if (dequeued > 0) {
+        currentStats.txDelayAvgUs = (uint32_t)(c.delayTotalUs / dequeued);
+    }
+    return currentStats;
+}
+
+const char* EthernetManager::trafficClassToString(EthTrafficClass cls) {
+    switch (cls) {
+        case EthTrafficClass::CONTROL: return "CONTROL";
+        case EthTrafficClass::HIGH: return "HIGH";
+        case EthTrafficClass::NORMAL: return "NORMAL";
+        case EthTrafficClass::BULK: return "BULK";
+        default: return "UNKNOWN";
+    }
+}
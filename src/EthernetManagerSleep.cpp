@@ -0,0 +1,117 @@
+// EthernetManagerSleep.cpp
+// Deep sleep: snapshot manager state into RTC memory, resume from it on wake
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+
+static constexpr uint32_t SLEEP_MAGIC = 0x45534C31;  // "ESL1"
+
+struct EthernetManager::SleepSnapshot {
+    uint32_t magic;
+    uint8_t mac[ETH_MAC_ADDRESS_SIZE];
+    bool customMac;
+    int8_t phyAddr;
+    DhcpLease lease;             // ip == 0: no DHCP binding to resume
+    NetworkStats stats;
+    uint32_t baselineWakeToIpMs; // Last start that did not resume a snapshot
+};
+
+// RTC slow memory survives deep sleep and is zeroed on power-on
+RTC_DATA_ATTR EthernetManager::SleepSnapshot EthernetManager::sleepSnapshot;
+
+bool EthernetManager::prepareForSleep(bool keepPhyPowered) {
+    auto& inst = getInstance();
+    if (!inst.phyStarted) {
+        inst.lastError = EthError::NOT_INITIALIZED;
+        return false;
+    }
+
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for sleep snapshot");
+        inst.lastError = EthError::MUTEX_TIMEOUT;
+        return false;
+    }
+
+    SleepSnapshot& snap = sleepSnapshot;
+    snap = {};
+    snap.customMac = inst.hasCustomMac;
+    memcpy(snap.mac, inst.customMacAddress, ETH_MAC_ADDRESS_SIZE);
+    snap.phyAddr = inst.beginPhyAddr;
+    if (!inst.staticIpMode && inst.addressSource == EthAddressSource::DHCP) {
+        inst.captureLease(snap.lease);
+    }
+    snap.stats = inst.stats;
+    snap.baselineWakeToIpMs = inst.sleepResumed ? inst.sleepBaselineMs : inst.bootToIpMs;
+    snap.magic = SLEEP_MAGIC;
+
+    if (keepPhyPowered) {
+        if (inst.warmStartEnabled) {
+            // Same record as esp_restart(); the wake then skips the PHY reset
+            warmShutdownHandler();
+            gpio_deep_sleep_hold_en();
+        } else {
+            ETH_LOG_W("Keeping the PHY powered in sleep needs warm start enabled");
+        }
+    }
+
+    ETH_LOG_I("Sleep snapshot saved (lease " IPSTR ")", IP2STR((esp_ip4_addr_t*)&snap.lease.ip));
+    return true;
+}
+
+bool EthernetManager::restoreSleepSnapshot(EthernetConfig& config) {
+    SleepSnapshot& snap = sleepSnapshot;
+    if (snap.magic != SLEEP_MAGIC) return false;
+    snap.magic = 0;  // One wake only
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP) return false;
+
+    sleepResumed = true;
+    sleepBaselineMs = snap.baselineWakeToIpMs;
+
+    // Counters carry on; times are relative to this boot
+    stats = snap.stats;
+    stats.connectTime = 0;
+    stats.uptimeMs = 0;
+    stats.sleepResumes++;
+
+    if (snap.customMac && !config.custom_mac) {
+        memcpy(customMacAddress, snap.mac, ETH_MAC_ADDRESS_SIZE);
+        hasCustomMac = true;
+    }
+    config.phy_addr = snap.phyAddr;
+
+    // Seeded at link up by the lease machinery, even with the NVS cache off
+    if (snap.lease.ip != 0 && !config.use_static_ip && createLeaseSeedTimer()) {
+        cachedLease = snap.lease;
+        leaseLoaded = true;
+        sleepLeasePending = true;
+        sleepLeaseTrusted = leaseWithinRenewal(snap.lease);
+    }
+
+    ETH_LOG_I("Resuming from sleep snapshot (PHY %d, lease " IPSTR ", %s)", snap.phyAddr,
+              IP2STR((esp_ip4_addr_t*)&snap.lease.ip), sleepLeaseTrusted ? "restore" : "request");
+    return true;
+}
+
+void EthernetManager::resumeSleepLease() {
+    if (connectionState == EthConnectionState::CONNECTED) return;
+
+    // Bound without DHCP: nothing for the fallback chain to time out
+    if (dhcpFallbackTimer) {
+        xTimerStop(dhcpFallbackTimer, 0);
+    }
+    xEventGroupSetBits(ethEventGroup, BIT_GOT_IP4);
+    addressSource = EthAddressSource::DHCP;
+    ETH_LOG_I("Sleep lease " IPSTR " restored, confirming in background",
+              IP2STR((esp_ip4_addr_t*)&heldLease.ip));
+
+    startArpPrewarm(heldLease.ip, heldLease.netmask, heldLease.gateway);
+    evaluateReadiness(true);
+}
+
+void EthernetManager::resumeSleepLeaseDeferred(void* param1, uint32_t param2) {
+    getInstance().resumeSleepLease();
+}
@@ -0,0 +1,90 @@
+// EthernetManagerSockets.cpp
+// Abort TCP connections bound to Ethernet once a disconnect is confirmed
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_netif.h>
+
+#include <lwip/netif.h>
+#include <lwip/priv/tcp_priv.h>
+#include <lwip/tcp.h>
+#include <lwip/tcpip.h>
+
+namespace {
+
+// PCB lists belong to the tcpip thread
+struct AbortCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+    uint32_t ip;
+    uint32_t aborted;
+};
+
+bool boundToEthernet(const struct tcp_pcb* pcb, const AbortCall* msg) {
+    if (msg->ip != 0 && IP_IS_V4_VAL(pcb->local_ip) &&
+        ip4_addr_get_u32(ip_2_ip4(&pcb->local_ip)) == msg->ip) {
+        return true;
+    }
+    // IPv6 and interface-bound connections
+    return pcb->netif_idx != NETIF_NO_INDEX && pcb->netif_idx == netif_get_index(msg->nif);
+}
+
+err_t abortInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<AbortCall*>(call);
+    msg->aborted = 0;
+
+    // tcp_abort() unlinks the PCB and runs the socket's error callback;
+    // rescan from the head rather than trusting pcb->next afterwards
+    bool found = true;
+    while (found) {
+        found = false;
+        for (struct tcp_pcb* pcb = tcp_active_pcbs; pcb != nullptr; pcb = pcb->next) {
+            if (boundToEthernet(pcb, msg)) {
+                tcp_abort(pcb);
+                msg->aborted++;
+                found = true;
+                break;
+            }
+        }
+    }
+    return ERR_OK;
+}
+
+}  // namespace
+
+void EthernetManager::setSocketAbortOnDisconnect(bool enable) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for TCP abort on disconnect");
+        return;
+    }
+    inst.socketAbortEnabled = enable;
+    ETH_LOG_I("TCP abort on disconnect %s", enable ? "enabled" : "disabled");
+}
+
+void EthernetManager::setSocketAbortCallback(EthSocketAbortCallback callback) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.socketAbortCallback = callback;
+    }
+}
+
+uint32_t EthernetManager::abortConnections() {
+    if (!eth_netif) return 0;
+
+    AbortCall msg = {};
+    msg.nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (!msg.nif) return 0;
+
+    // The netif address may already be zeroed; match the last binding too
+    msg.ip = heldLease.ip;
+    tcpip_api_call(abortInTcpip, &msg.call);
+
+    if (msg.aborted > 0) {
+        stats.tcpAborts += msg.aborted;
+        ETH_LOG_W("Aborted %u TCP connection(s) on link loss", msg.aborted);
+    }
+    return msg.aborted;
+}
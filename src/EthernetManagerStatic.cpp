@@ -0,0 +1,78 @@
+// EthernetManagerStatic.cpp
+// Static-IP fast path: report CONNECTED at link up instead of waiting for GOT_IP
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_netif.h>
+#include <esp_timer.h>
+
+#include <lwip/netif.h>
+#include <lwip/tcpip.h>
+
+namespace {
+
+// esp_netif brings the lwIP netif up from its own link handler, which may
+// run after ours; do it here so traffic can flow once CONNECTED is reported
+struct NetifUpCall {
+    struct tcpip_api_call_data call;
+    struct netif* nif;
+};
+
+err_t netifUpInTcpip(struct tcpip_api_call_data* call) {
+    auto* msg = reinterpret_cast<NetifUpCall*>(call);
+    netif_set_up(msg->nif);
+    netif_set_link_up(msg->nif);
+    return ERR_OK;
+}
+
+}  // namespace
+
+void EthernetManager::setStaticFastPath(bool enable) {
+    auto& inst = getInstance();
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        ETH_LOG_E("Failed to take mutex for static IP fast path");
+        return;
+    }
+    inst.staticFastPathEnabled = enable;
+    ETH_LOG_I("Static IP fast path %s", enable ? "enabled" : "disabled");
+}
+
+bool EthernetManager::applyStaticFastPath() {
+    if (!staticFastPathEnabled || !staticIpMode || !eth_netif || (uint32_t)staticIp == 0) {
+        return false;
+    }
+
+    NetifUpCall msg = {};
+    msg.nif = static_cast<struct netif*>(esp_netif_get_netif_impl(eth_netif));
+    if (!msg.nif) return false;
+    tcpip_api_call(netifUpInTcpip, &msg.call);
+
+    staticFastPathPending = true;
+    staticFastPathUs = esp_timer_get_time();
+
+    xEventGroupSetBits(ethEventGroup, BIT_GOT_IP4);
+    addressSource = EthAddressSource::STATIC;
+    heldLease.ip = (uint32_t)staticIp;
+    heldLease.netmask = (uint32_t)staticSubnet;
+    heldLease.gateway = (uint32_t)staticGateway;
+    startArpPrewarm(heldLease.ip, heldLease.netmask, heldLease.gateway);
+
+    ETH_LOG_I("Static IP fast path: connected at link up");
+    evaluateReadiness(true);
+    return true;
+}
+
+bool EthernetManager::consumeStaticGotIp(uint32_t ip) {
+    if (!staticFastPathPending) return false;
+    staticFastPathPending = false;
+
+    // Address changed underneath us: let the normal path announce it
+    if (ip != heldLease.ip) return false;
+
+    staticFastPathSavedUs = (uint32_t)(esp_timer_get_time() - staticFastPathUs);
+    staticFastPathSavedTotalUs += staticFastPathSavedUs;
+    staticFastPathCount++;
+    ETH_LOG_D("Static IP fast path ahead of GOT_IP by %u us", staticFastPathSavedUs);
+    return true;
+}
@@ -0,0 +1,63 @@
+// EthernetManagerTokenBucket.h
+// Token buckets shared by the receive classifier (packets) and the traffic
+// shaper (bytes); templates so they work on the manager's private bucket types
+#pragma once
+
+#include <stdint.h>
+
+struct TokenBucket {
+    // Classifier rules count in 1/1000 tokens, one token per packet
+    static constexpr uint32_t MILLI_TOKENS = 1000;
+
+    // Refill by elapsed time, then take a token if there is one. Only the time
+    // turned into whole milli-tokens is consumed, so low rates don't lose the
+    // remainder when frames arrive microseconds apart.
+    template <typename Rule>
+    static bool take(Rule& rule, int64_t nowUs) {
+        if (rule.ratePps == 0) return false;
+
+        uint64_t add = (uint64_t)(nowUs - rule.refilledUs) * rule.ratePps / 1000;
+        if (rule.tokensMilli + add >= rule.burstMilli) {
+            rule.tokensMilli = rule.burstMilli;
+            rule.refilledUs = nowUs;
+        } else if (add > 0) {
+            rule.tokensMilli += add;
+            rule.refilledUs += (int64_t)(add * 1000 / rule.ratePps);
+        }
+
+        if (rule.tokensMilli < MILLI_TOKENS) return false;
+        rule.tokensMilli -= MILLI_TOKENS;
+        return true;
+    }
+
+    // Same carry scheme in bytes; a zero rate is unlimited
+    template <typename Bucket>
+    static void refill(Bucket& bucket, int64_t nowUs) {
+        if (bucket.bytesPerSec == 0) return;
+        uint64_t add = (uint64_t)(nowUs - bucket.refilledUs) * bucket.bytesPerSec / 1000000;
+        if (bucket.tokens + add >= bucket.burst) {
+            bucket.tokens = bucket.burst;
+            bucket.refilledUs = nowUs;
+        } else if (add > 0) {
+            bucket.tokens += add;
+            bucket.refilledUs += (int64_t)(add * 1000000 / bucket.bytesPerSec);
+        }
+    }
+
+    template <typename Bucket>
+    static bool hasTokens(const Bucket& bucket, uint32_t bytes) {
+        return bucket.bytesPerSec == 0 || bucket.tokens >= bytes;
+    }
+
+    template <typename Bucket>
+    static void consume(Bucket& bucket, uint32_t bytes) {
+        if (bucket.bytesPerSec != 0) bucket.tokens -= bytes;
+    }
+
+    // Time until `bytes` fit, without refilling
+    template <typename Bucket>
+    static uint32_t waitUs(const Bucket& bucket, uint32_t bytes) {
+        if (hasTokens(bucket, bytes)) return 0;
+        return (uint32_t)((uint64_t)(bytes - bucket.tokens) * 1000000 / bucket.bytesPerSec) + 1;
+    }
+};
@@ -0,0 +1,324 @@
+// EthernetManagerVlan.cpp
+// 802.1Q VLANs: tagged TX/RX for the Ethernet interface, virtual interfaces
+// per VLAN id, priority code points from the traffic class, per-VLAN counters
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <esp_eth.h>
+
+#include <lwip/pbuf.h>
+
+static constexpr uint16_t ETHERTYPE_VLAN = 0x8100;
+static constexpr uint32_t MAC_PAIR_LEN = 12;       // Destination + source
+static constexpr uint32_t VLAN_TAG_LEN = 4;
+static constexpr uint32_t ETH_MAX_TAGGED_FRAME = 1518;
+static constexpr uint16_t VLAN_VID_MASK = 0x0FFF;
+static constexpr uint16_t VLAN_VID_MAX = 4094;
+
+namespace {
+
+// Virtual interfaces transmit from the lwIP core, and esp_eth_transmit()
+// copies into the DMA ring before returning, so one scratch frame is enough
+uint8_t taggedFrame[ETH_MAX_TAGGED_FRAME];
+
+}  // namespace
+
+bool EthernetManager::vlanActive() const {
+    return vlanId != 0 || vlanInterfaceCount > 0;
+}
+
+bool EthernetManager::setVlan(uint16_t vid) {
+    auto& inst = getInstance();
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+        bool duplicate = false;
+        for (uint8_t i = 0; i < inst.vlanInterfaceCount; i++) {
+            duplicate |= inst.vlanInterfaces[i].vid == vid;
+        }
+        if (vid > VLAN_VID_MAX || (vid && duplicate)) {
+            inst.lastError = EthError::INVALID_PARAMETER;
+            return false;
+        }
+
+        inst.vlanId = vid;
+        inst.vlanStats = {};
+        inst.vlanStats.vid = vid;
+    }
+
+    // Without a driver both hooks go in at ETHERNET_EVENT_START
+    if (inst.ethHandle) {
+        inst.attachEgressHook();
+        if (inst.vlanActive()) {
+            inst.installStackInput();
+        }
+    }
+    if (vid) {
+        ETH_LOG_I("Ethernet interface on VLAN %u", vid);
+    } else {
+        ETH_LOG_I("Ethernet interface untagged");
+    }
+    return true;
+}
+
+bool EthernetManager::addVlanInterface(uint16_t vid) {
+    auto& inst = getInstance();
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            return false;
+        }
+
+        bool duplicate = vid == inst.vlanId;
+        for (uint8_t i = 0; i < inst.vlanInterfaceCount; i++) {
+            duplicate |= inst.vlanInterfaces[i].vid == vid;
+        }
+        if (vid == 0 || vid > VLAN_VID_MAX || duplicate || inst.vlanInterfaceCount >= ETH_MAX_VLANS) {
+            inst.lastError = EthError::INVALID_PARAMETER;
+            return false;
+        }
+
+        // Filled in before the count makes it visible to the receive task
+        VlanInterface& vlan = inst.vlanInterfaces[inst.vlanInterfaceCount];
+        vlan.vid = vid;
+        vlan.netif = nullptr;
+        vlan.stats = {};
+        vlan.stats.vid = vid;
+        inst.vlanInterfaceCount = inst.vlanInterfaceCount + 1;
+    }
+
+    if (inst.ethHandle) {
+        // Also reprograms the EMAC filter, which now has to pass all multicast
+        inst.restoreReceivePath();
+        inst.forwardVlanEvent(ETHERNET_EVENT_START);
+        if (EthBackend::linkUp()) {
+            inst.forwardVlanEvent(ETHERNET_EVENT_CONNECTED);
+        }
+    }
+    return true;
+}
+
+esp_netif_t* EthernetManager::getVlanInterface(uint16_t vid) {
+    auto& inst = getInstance();
+    for (uint8_t i = 0; i < inst.vlanInterfaceCount; i++) {
+        if (inst.vlanInterfaces[i].vid == vid) return inst.vlanInterfaces[i].netif;
+    }
+    return nullptr;
+}
+
+void EthernetManager::setVlanPriority(EthTrafficClass cls, uint8_t pcp) {
+    auto& inst = getInstance();
+    if ((uint8_t)cls >= TRAFFIC_CLASSES || pcp > 7) {
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return;
+    }
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        inst.vlanPcp[(uint8_t)cls] = pcp;
+    }
+}
+
+VlanStats EthernetManager::getVlanStats(uint16_t vid) {
+    auto& inst = getInstance();
+    VlanStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) {
+        return currentStats;
+    }
+
+    // Counters are single words written by one task each
+    if (vid != 0 && vid == inst.vlanId) {
+        currentStats = inst.vlanStats;
+    }
+    for (uint8_t i = 0; i < inst.vlanInterfaceCount; i++) {
+        if (inst.vlanInterfaces[i].vid == vid) currentStats = inst.vlanInterfaces[i].stats;
+    }
+    return currentStats;
+}
+
+esp_netif_t* EthernetManager::vlanInput(uint8_t* buffer, uint32_t& length, esp_netif_t* netif) {
+    if (length < MAC_PAIR_LEN + VLAN_TAG_LEN + 2) return netif;
+
+    uint16_t etherType = ((uint16_t)buffer[12] << 8) | buffer[13];
+    uint16_t vid = etherType == ETHERTYPE_VLAN ? ((((uint16_t)buffer[14] << 8) | buffer[15]) & VLAN_VID_MASK) : 0;
+
+    // Untagged and priority-tagged (VID 0) frames belong to an untagged interface
+    esp_netif_t* target = nullptr;
+    VlanStats* counters = nullptr;
+    if (vid == vlanId) {
+        target = netif;
+        counters = vid ? &vlanStats : nullptr;
+    } else {
+        uint8_t count = vlanInterfaceCount;
+        for (uint8_t i = 0; i < count; i++) {
+            if (vlanInterfaces[i].vid == vid && vlanInterfaces[i].netif) {
+                target = vlanInterfaces[i].netif;
+                counters = &vlanInterfaces[i].stats;
+                break;
+            }
+        }
+    }
+    if (!target) {
+        stats.rxVlanDropped++;
+        return nullptr;
+    }
+
+    if (etherType == ETHERTYPE_VLAN) {
+        // Close the gap in place: the driver frees the buffer by its start address
+        memmove(buffer + MAC_PAIR_LEN, buffer + MAC_PAIR_LEN + VLAN_TAG_LEN,
+                length - MAC_PAIR_LEN - VLAN_TAG_LEN);
+        length -= VLAN_TAG_LEN;
+    }
+    if (counters) {
+        counters->rxFrames++;
+        counters->rxBytes += length;
+    }
+    return target;
+}
+
+esp_err_t EthernetManager::transmitTagged(uint16_t vid, const uint8_t* frame, size_t length, VlanStats& counters) {
+    if (!ethHandle || length < MAC_PAIR_LEN || length + VLAN_TAG_LEN > sizeof(taggedFrame)) {
+        counters.txErrors++;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t pcp = vlanPcp[(uint8_t)classifyTraffic(frame, length)];
+    uint16_t tci = ((uint16_t)pcp << 13) | vid;
+
+    memcpy(taggedFrame, frame, MAC_PAIR_LEN);
+    taggedFrame[12] = ETHERTYPE_VLAN >> 8;
+    taggedFrame[13] = ETHERTYPE_VLAN & 0xFF;
+    taggedFrame[14] = tci >> 8;
+    taggedFrame[15] = tci & 0xFF;
+    memcpy(taggedFrame + MAC_PAIR_LEN + VLAN_TAG_LEN, frame + MAC_PAIR_LEN, length - MAC_PAIR_LEN);
+
+    esp_err_t err = esp_eth_transmit(ethHandle, taggedFrame, length + VLAN_TAG_LEN);
+    if (err == ESP_OK) {
+        counters.txFrames++;
+        counters.txBytes += length;
+    } else {
+        counters.txErrors++;
+    }
+    return err;
+}
+
+struct pbuf* EthernetManager::vlanTag(struct pbuf* p) {
+    if (p->tot_len < MAC_PAIR_LEN || p->tot_len + VLAN_TAG_LEN > ETH_MAX_TAGGED_FRAME) return nullptr;
+
+    struct pbuf* tagged = pbuf_alloc(PBUF_RAW, p->tot_len + VLAN_TAG_LEN, PBUF_RAM);
+    if (!tagged) return nullptr;
+
+    // lwIP keeps the Ethernet and IP headers in the first pbuf
+    uint8_t pcp = vlanPcp[(uint8_t)classifyTraffic(static_cast<const uint8_t*>(p->payload), p->len)];
+    uint16_t tci = ((uint16_t)pcp << 13) | vlanId;
+
+    auto* frame = static_cast<uint8_t*>(tagged->payload);
+    pbuf_copy_partial(p, frame, MAC_PAIR_LEN, 0);
+    frame[12] = ETHERTYPE_VLAN >> 8;
+    frame[13] = ETHERTYPE_VLAN & 0xFF;
+    frame[14] = tci >> 8;
+    frame[15] = tci & 0xFF;
+    pbuf_copy_partial(p, frame + MAC_PAIR_LEN + VLAN_TAG_LEN, p->tot_len - MAC_PAIR_LEN, MAC_PAIR_LEN);
+    return tagged;
+}
+
+esp_err_t EthernetManager::vlanInterfaceTransmit(void* handle, void* buffer, size_t length) {
+    auto* vlan = static_cast<VlanInterface*>(handle);
+    return getInstance().transmitTagged(vlan->vid, static_cast<const uint8_t*>(buffer), length, vlan->stats);
+}
+
+esp_err_t EthernetManager::vlanInterfaceTransmitWrap(void* handle, void* buffer, size_t length, void* netstackBuffer) {
+    return vlanInterfaceTransmit(handle, buffer, length);
+}
+
+esp_err_t EthernetManager::vlanPostAttach(esp_netif_t* netif, void* handle) {
+    auto* vlan = static_cast<VlanInterface*>(handle);
+    vlan->base.netif = netif;
+
+    // Every callback is set: esp_netif takes the whole config
+    esp_netif_driver_ifconfig_t driver = {};
+    driver.handle = vlan;
+    driver.transmit = vlanInterfaceTransmit;
+    driver.transmit_wrap = vlanInterfaceTransmitWrap;
+    driver.driver_free_rx_buffer = vlanFreeRxBuffer;
+    return esp_netif_set_driver_config(netif, &driver);
+}
+
+void EthernetManager::vlanFreeRxBuffer(void* handle, void* buffer) {
+    free(buffer);  // EMAC receive buffers are plain heap allocations
+}
+
+void EthernetManager::destroyVlanInterfaces() {
+    // The receive hook stops routing to them before they go
+    uint8_t count = vlanInterfaceCount;
+    vlanInterfaceCount = 0;
+    vlanId = 0;
+    vlanStats = {};
+
+    for (uint8_t i = 0; i < count; i++) {
+        VlanInterface& vlan = vlanInterfaces[i];
+        if (vlan.netif) {
+            esp_netif_destroy(vlan.netif);
+            vlan.netif = nullptr;
+            ETH_LOG_D("VLAN %u interface destroyed", vlan.vid);
+        }
+    }
+}
+
+void EthernetManager::forwardVlanEvent(int32_t id) {
+    uint8_t count = vlanInterfaceCount;
+    for (uint8_t i = 0; i < count; i++) {
+        VlanInterface& vlan = vlanInterfaces[i];
+
+        if (id == ETHERNET_EVENT_START && !vlan.netif) {
+            char key[16], desc[16];
+            snprintf(key, sizeof(key), "ETH_VLAN%u", vlan.vid);
+            snprintf(desc, sizeof(desc), "vlan%u", vlan.vid);
+
+            // Same addressing defaults as the Ethernet interface, lower route priority
+            esp_netif_inherent_config_t base = ESP_NETIF_INHERENT_DEFAULT_ETH();
+            base.if_key = key;
+            base.if_desc = desc;
+            base.route_prio -= 1 + i;
+            esp_netif_config_t config = {};
+            config.base = &base;
+            config.stack = ESP_NETIF_NETSTACK_DEFAULT_ETH;
+
+            esp_netif_t* netif = esp_netif_new(&config);
+            vlan.base.post_attach = vlanPostAttach;
+            if (!netif || esp_netif_attach(netif, &vlan) != ESP_OK) {
+                ETH_LOG_E("Failed to create the VLAN %u interface", vlan.vid);
+                if (netif) esp_netif_destroy(netif);
+                continue;
+            }
+
+            uint8_t mac[6];
+            if (esp_eth_ioctl(ethHandle, ETH_CMD_G_MAC_ADDR, mac) == ESP_OK) {
+                esp_netif_set_mac(netif, mac);
+            }
+            vlan.netif = netif;
+            ETH_LOG_I("VLAN %u interface created", vlan.vid);
+        }
+        if (!vlan.netif) continue;
+
+        switch (id) {
+            case ETHERNET_EVENT_START:
+                esp_netif_action_start(vlan.netif, ETH_EVENT, id, nullptr);
+                break;
+            case ETHERNET_EVENT_CONNECTED:
+                esp_netif_action_connected(vlan.netif, ETH_EVENT, id, nullptr);
+                break;
+            case ETHERNET_EVENT_DISCONNECTED:
+                esp_netif_action_disconnected(vlan.netif, ETH_EVENT, id, nullptr);
+                break;
+            case ETHERNET_EVENT_STOP:
+                esp_netif_action_stop(vlan.netif, ETH_EVENT, id, nullptr);
+                break;
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,247 @@
+// EthernetManagerWakeOnLan.cpp
+// Wake-on-LAN: SUSPENDED state with a magic packet filter on the driver
+// receive path, and optional light sleep woken by the PHY interrupt pin
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <driver/gpio.h>
+#include <esp_eth.h>
+#include <esp_sleep.h>
+
+static constexpr uint32_t ETH_HEADER_LEN = 14;
+static constexpr uint32_t MAGIC_SYNC_LEN = 6;
+static constexpr uint32_t MAGIC_REPEATS = 16;
+static constexpr uint32_t MAGIC_LEN = MAGIC_SYNC_LEN + MAGIC_REPEATS * 6;
+
+// Sync stream of six 0xFF then the target MAC 16 times, anywhere in the payload
+bool EthernetManager::isMagicPacket(const uint8_t* frame, uint32_t length, const uint8_t* mac) {
+    if (length < ETH_HEADER_LEN + MAGIC_LEN) return false;
+
+    for (uint32_t i = ETH_HEADER_LEN; i + MAGIC_LEN <= length; i++) {
+        if (frame[i] != 0xFF) continue;
+
+        uint32_t sync = 1;
+        while (sync < MAGIC_SYNC_LEN && frame[i + sync] == 0xFF) sync++;
+        if (sync < MAGIC_SYNC_LEN) {
+            i += sync;
+            continue;
+        }
+
+        const uint8_t* target = frame + i + MAGIC_SYNC_LEN;
+        uint32_t repeats = 0;
+        while (repeats < MAGIC_REPEATS && memcmp(target + repeats * 6, mac, 6) == 0) repeats++;
+        if (repeats == MAGIC_REPEATS) return true;
+    }
+    return false;
+}
+
+void EthernetManager::setWakeOnLan(bool enable, int8_t wakePin) {
+    auto& inst = getInstance();
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for Wake-on-LAN");
+            return;
+        }
+        // suspend() checks the flag under the mutex, so nothing arms after this
+        inst.wolEnabled = enable;
+        inst.wolWakePin = wakePin;
+    }
+
+    // State callbacks run outside the mutex; a no-op unless armed
+    if (!enable) {
+        inst.resumeFromSuspend(false);
+    }
+    ETH_LOG_I("Wake-on-LAN %s (wake pin %d)", enable ? "enabled" : "disabled", wakePin);
+}
+
+bool EthernetManager::suspend() {
+    auto& inst = getInstance();
+    if (!inst.wolEnabled) {
+        ETH_LOG_E("Wake-on-LAN not enabled");
+        inst.lastError = EthError::INVALID_PARAMETER;
+        return false;
+    }
+    if (!inst.phyStarted || !inst.ethHandle || !inst.eth_netif || inst.phyLowPower) {
+        ETH_LOG_E("Suspend needs a running driver with the PHY powered");
+        inst.lastError = EthError::NOT_INITIALIZED;
+        return false;
+    }
+    if (inst.connectionState == EthConnectionState::SUSPENDED) return true;
+
+    if (esp_eth_ioctl(inst.ethHandle, ETH_CMD_G_MAC_ADDR, inst.wolMac) != ESP_OK) {
+        ETH_LOG_E("Suspend: failed to read the MAC address");
+        inst.lastError = EthError::CONFIG_FAILED;
+        return false;
+    }
+
+    // The receive hook passes frames through until the filter is armed below
+    if (!inst.installStackInput()) {
+        ETH_LOG_E("Suspend: failed to install the receive filter");
+        inst.lastError = EthError::CONFIG_FAILED;
+        return false;
+    }
+
+    {
+        MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard) {
+            ETH_LOG_E("Failed to take mutex for suspend");
+            inst.lastError = EthError::MUTEX_TIMEOUT;
+            return false;
+        }
+        if (!inst.wolEnabled) {
+            inst.lastError = EthError::INVALID_PARAMETER;
+            return false;  // Disabled since the check above
+        }
+        // The address stays on the netif; only the ready bit drops
+        inst.wolMatched = false;
+        inst.wolArmed = true;
+        xEventGroupClearBits(inst.ethEventGroup, BIT_WOL_WAKE | BIT_CONNECTED);
+        inst.suspendedSince = millis();
+        inst.wolStats.suspends++;
+    }
+
+    inst.changeState(EthConnectionState::SUSPENDED);
+    ETH_LOG_I("Suspended - waiting for a magic packet to %02X:%02X:%02X:%02X:%02X:%02X",
+              inst.wolMac[0], inst.wolMac[1], inst.wolMac[2],
+              inst.wolMac[3], inst.wolMac[4], inst.wolMac[5]);
+    return true;
+}
+
+bool EthernetManager::resume() {
+    return getInstance().resumeFromSuspend(false);
+}
+
+bool EthernetManager::resumeFromSuspend(bool magic) {
+    {
+        MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_STANDARD_TIMEOUT_MS));
+        if (!guard || !wolArmed) return false;
+
+        // First caller wins: the filter's deferred call or resume()
+        wolArmed = false;
+        wolStats.suspendedMs += millis() - suspendedSince;
+        if (magic) {
+            wolStats.magicWakes++;
+        }
+    }
+
+    ETH_LOG_I("Resumed from SUSPENDED (%s)", magic ? "magic packet" : "requested");
+
+    // Link changes were not reported while suspended; report the current state
+    if (!EthBackend::linkUp()) {
+        lastLinkStatus = false;
+        clearAddresses();
+        changeState(EthConnectionState::LINK_DOWN);
+    } else if (readinessSatisfied()) {
+        evaluateReadiness(true);
+    } else {
+        changeState(EthConnectionState::OBTAINING_IP);
+    }
+    return true;
+}
+
+void EthernetManager::resumeFromSuspendDeferred(void* param1, uint32_t param2) {
+    getInstance().resumeFromSuspend(true);
+}
+
+void EthernetManager::wolFilterFrame(uint8_t* buffer, uint32_t length) {
+    // Runs on the EMAC receive task: match, free, and leave the rest to the timer task
+    bool magic = !wolMatched && isMagicPacket(buffer, length, wolMac);
+    free(buffer);
+    if (!magic) {
+        wolFramesDropped++;
+        return;
+    }
+
+    wolMatched = true;
+    xEventGroupSetBits(ethEventGroup, BIT_WOL_WAKE);
+    if (xTimerPendFunctionCall(resumeFromSuspendDeferred, nullptr, 0, 0) != pdPASS) {
+        ETH_LOG_W("Magic packet matched but resume could not be queued");
+    }
+}
+
+void EthernetManager::countWolSleep(bool spurious) {
+    MutexGuard guard(ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (!guard) return;
+    if (spurious) {
+        wolStats.spuriousWakes++;
+    } else {
+        wolStats.lightSleeps++;
+    }
+}
+
+bool EthernetManager::waitForWake(uint32_t timeoutMs) {
+    auto& inst = getInstance();
+    if (!inst.ethEventGroup) return false;
+
+    uint32_t start = millis();
+    while (inst.wolArmed) {
+        uint32_t elapsed = millis() - start;
+        if (timeoutMs != portMAX_DELAY && elapsed >= timeoutMs) break;
+        uint32_t remaining = timeoutMs == portMAX_DELAY ? portMAX_DELAY : timeoutMs - elapsed;
+
+        if (inst.wolMatched) {
+            break;
+        }
+
+        // No wake pin: the CPU idles in FreeRTOS while the filter runs
+        if (inst.wolWakePin < 0) {
+            xEventGroupWaitBits(inst.ethEventGroup, BIT_WOL_WAKE, pdFALSE, pdFALSE,
+                                remaining == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(remaining));
+            continue;
+        }
+
+        gpio_num_t pin = (gpio_num_t)inst.wolWakePin;
+        gpio_set_direction(pin, GPIO_MODE_INPUT);
+        gpio_wakeup_enable(pin, ETH_WOL_WAKE_LEVEL ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+        if (remaining != portMAX_DELAY) {
+            esp_sleep_enable_timer_wakeup((uint64_t)remaining * 1000);
+        }
+
+        inst.countWolSleep(false);
+        esp_light_sleep_start();
+        esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+        gpio_wakeup_disable(pin);
+
+        if (cause == ESP_SLEEP_WAKEUP_TIMER) continue;
+
+        // Give the EMAC time to hand the frame that woke us to the filter
+        EventBits_t bits = xEventGroupWaitBits(inst.ethEventGroup, BIT_WOL_WAKE, pdFALSE, pdFALSE,
+                                               pdMS_TO_TICKS(ETH_WOL_VERIFY_MS));
+        if (bits & BIT_WOL_WAKE) break;
+
+        inst.countWolSleep(true);
+        ETH_LOG_D("Spurious wake (cause %d), back to sleep", cause);
+
+        // A level that is still asserted would wake us again at once
+        uint32_t waited = 0;
+        while (gpio_get_level(pin) == ETH_WOL_WAKE_LEVEL && waited < ETH_WOL_VERIFY_MS && !inst.wolMatched) {
+            vTaskDelay(1);
+            waited += portTICK_PERIOD_MS;
+        }
+    }
+
+    if (!inst.wolMatched) return false;
+
+    // Don't hand control back before the state machine has left SUSPENDED
+    inst.resumeFromSuspend(true);
+    return true;
+}
+
+WakeOnLanStats EthernetManager::getWakeOnLanStats() {
+    auto& inst = getInstance();
+    WakeOnLanStats currentStats = {};
+    MutexGuard guard(inst.ethMutex, pdMS_TO_TICKS(ETH_MUTEX_QUICK_TIMEOUT_MS));
+    if (guard) {
+        currentStats = inst.wolStats;
+        currentStats.framesDropped = inst.wolFramesDropped;
+        if (inst.wolArmed) {
+            currentStats.suspendedMs += millis() - inst.suspendedSince;
+        }
+    }
+    return currentStats;
+}
@@ -0,0 +1,106 @@
+// EthernetManagerWarm.cpp
+// Warm restart: keep the PHY powered and negotiated across esp_restart()
+#include "EthernetManager.h"
+#include "MutexGuard.h"
+
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+static constexpr uint32_t WARM_MAGIC = 0x45574D31;  // "EWM1"
+
+// IEEE 802.3 basic status register
+static constexpr uint32_t PHY_REG_BMSR = 1;
+static constexpr uint32_t BMSR_LINK_STATUS = 0x0004;
+static constexpr uint32_t BMSR_AUTONEG_COMPLETE = 0x0020;
+
+namespace {
+
+// Survives esp_restart(); garbage after power-on, hence the magic
+struct WarmState {
+    uint32_t magic;
+    int8_t phyAddr;
+    int8_t powerPin;
+    uint32_t coldBootToLinkMs;   // Baseline carried across warm restarts
+};
+
+RTC_NOINIT_ATTR WarmState warmState;
+
+void releasePowerHold(int8_t pin) {
+    if (pin < 0) return;
+    // Drive the register high first so dropping the hold cannot glitch the pad
+    gpio_set_direction((gpio_num_t)pin, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)pin, 1);
+    gpio_hold_dis((gpio_num_t)pin);
+    gpio_deep_sleep_hold_dis();  // Set by prepareForSleep(true)
+}
+
+}  // namespace
+
+void EthernetManager::setWarmStart(bool enable) {
+    auto& inst = getInstance();
+
+    // Already (un)registered is reported as ESP_ERR_INVALID_STATE
+    esp_err_t err = enable ? esp_register_shutdown_handler(warmShutdownHandler) :
+                             esp_unregister_shutdown_handler(warmShutdownHandler);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ETH_LOG_E("Failed to %s warm start shutdown handler: %d", enable ? "register" : "remove", err);
+        inst.lastError = EthError::CONFIG_FAILED;
+        return;
+    }
+
+    inst.warmStartEnabled = enable;
+    ETH_LOG_I("Warm start %s", enable ? "enabled" : "disabled");
+}
+
+void EthernetManager::warmShutdownHandler() {
+    auto& inst = getInstance();
+    warmState.magic = 0;
+
+    // Only a negotiated link is worth keeping; otherwise the next boot is cold anyway
+    if (!inst.warmStartEnabled || !inst.phyStarted || !EthBackend::linkUp()) {
+        return;
+    }
+
+    // A software reset returns pads to their defaults unless held
+    if (inst.beginPowerPin >= 0) {
+        gpio_hold_en((gpio_num_t)inst.beginPowerPin);
+    }
+    warmState.phyAddr = inst.beginPhyAddr;
+    warmState.powerPin = inst.beginPowerPin;
+    warmState.coldBootToLinkMs = inst.warmBoot ? inst.warmBaselineMs : inst.bootToLinkMs;
+    warmState.magic = WARM_MAGIC;
+}
+
+void EthernetManager::prepareWarmBoot() {
+    keepPhyState = false;
+    if (warmState.magic != WARM_MAGIC) return;
+    warmState.magic = 0;  // One boot only
+
+    // prepareForSleep(true) leaves the same record for a deep-sleep wake
+    esp_reset_reason_t reason = esp_reset_reason();
+    if (warmStartEnabled && (reason == ESP_RST_SW || reason == ESP_RST_DEEPSLEEP) &&
+        warmState.phyAddr == beginPhyAddr && warmState.powerPin == beginPowerPin) {
+        uint32_t bmsr = 0;
+        esp_eth_mac_t* mac = ethOpenSmi(backendConfig());
+        if (mac) {
+            // Link status latches low: the second read is the current state
+            mac->read_phy_reg(mac, beginPhyAddr, PHY_REG_BMSR, &bmsr);
+            mac->read_phy_reg(mac, beginPhyAddr, PHY_REG_BMSR, &bmsr);
+            ethCloseSmi(mac);
+        }
+
+        const uint32_t ready = BMSR_LINK_STATUS | BMSR_AUTONEG_COMPLETE;
+        keepPhyState = (bmsr & ready) == ready;
+        if (keepPhyState) {
+            ETH_LOG_I("Warm start: PHY link still negotiated, skipping PHY reset");
+        } else {
+            ETH_LOG_W("Warm start: PHY not linked (BMSR %04X), starting cold", bmsr);
+        }
+    }
+
+    releasePowerHold(warmState.powerPin);
+    warmBoot = keepPhyState;
+    warmBaselineMs = warmBoot ? warmState.coldBootToLinkMs : 0;
+}
@@ -3,10 +3,119 @@
 #include "../test_config.h"
 #include "../mocks/MockETH.h"
 #include "../../src/EthernetManager.h"
+#include "../../src/EthernetManagerBackend.h"
+#include "../../src/EthernetManagerTokenBucket.h"
 
 // External mock instance
 extern MockETHClass MockETH;
 
+// Private helpers, reached through the friend declaration in EthernetManager
+struct EthernetManagerTest {
+    using RxRule = EthernetManager::RxRule;
+    using ShaperBucket = EthernetManager::ShaperBucket;
+
+    static uint32_t nextBackoffDelay(uint8_t attempts, uint32_t prev) {
+        auto& inst = EthernetManager::getInstance();
+        inst.reconnectAttempts = attempts;
+        inst.reconnectCurrentDelay = prev;
+        return inst.nextBackoffDelay();
+    }
+    static EthBackoffPolicy backoffPolicy() { return EthernetManager::getInstance().backoffPolicy; }
+
+    static float decayFlapPenalty(float penalty, uint32_t ageMs) {
+        auto& inst = EthernetManager::getInstance();
+        inst.flapPenalty = penalty;
+        inst.flapPenaltyUpdated = millis() - ageMs;
+        return inst.decayFlapPenalty();
+    }
+    static void recordFlap() { EthernetManager::getInstance().recordFlap(); }
+    static float flapPenalty() { return EthernetManager::getInstance().flapPenalty; }
+    static bool linkSuppressed() { return EthernetManager::getInstance().linkSuppressed; }
+    static bool flapDampingEnabled() { return EthernetManager::getInstance().flapDampingEnabled; }
+    static uint32_t linkHoldGraceMs() { return EthernetManager::getInstance().linkHoldGraceMs; }
+    static bool socketAbortEnabled() { return EthernetManager::getInstance().socketAbortEnabled; }
+    static bool leaseCacheEnabled() { return EthernetManager::getInstance().leaseCacheEnabled; }
+
+    // Deliver an ETH_EVENT as the driver would; any handle matches without a backend one
+    static void ethEvent(int32_t id, esp_eth_handle_t handle = nullptr) {
+        auto& inst = EthernetManager::getInstance();
+        esp_eth_handle_t saved = inst.ethHandle;
+        if (!handle) {
+            handle = EthBackend::handle();
+        }
+        if (!handle) {
+            handle = reinterpret_cast<esp_eth_handle_t>(&inst);
+        }
+        EthernetManager::onEthEvent(nullptr, ETH_EVENT, id, &handle);
+        inst.ethHandle = saved;
+    }
+    static void ipEvent(int32_t id, esp_netif_t* netif, uint32_t ip) {
+        ip_event_got_ip_t event = {};
+        event.esp_netif = netif;
+        event.ip_info.ip.addr = ip;
+        event.ip_changed = true;
+        EthernetManager::onEthEvent(nullptr, IP_EVENT, id, &event);
+    }
+    // Connected with an address, as evaluateReadiness() leaves it
+    static void markConnected(uint32_t connectedForMs = 0) {
+        auto& inst = EthernetManager::getInstance();
+        inst.gotIpAtLeastOnce = true;
+        inst.connectionStartTime = millis() - connectedForMs;
+        inst.changeState(EthConnectionState::CONNECTED);
+        xEventGroupSetBits(inst.ethEventGroup, EthernetManager::BIT_CONNECTED);
+    }
+    static void holdAddress(uint32_t ip, EthAddressSource source) {
+        auto& inst = EthernetManager::getInstance();
+        inst.heldLease.ip = ip;
+        inst.addressSource = source;
+        xEventGroupSetBits(inst.ethEventGroup, EthernetManager::BIT_GOT_IP4);
+    }
+    static bool consumeHeldAddress(uint32_t ip) { return EthernetManager::getInstance().consumeHeldAddress(ip); }
+    static void setReadyPolicy(EthIpReadyPolicy policy) { EthernetManager::getInstance().readyPolicy = policy; }
+    static void setAddressBits(bool v4, bool v6) {
+        auto& inst = EthernetManager::getInstance();
+        xEventGroupClearBits(inst.ethEventGroup, EthernetManager::BIT_GOT_IP4 | EthernetManager::BIT_GOT_IP6);
+        xEventGroupSetBits(inst.ethEventGroup, (v4 ? EthernetManager::BIT_GOT_IP4 : 0) |
+                                               (v6 ? EthernetManager::BIT_GOT_IP6 : 0));
+    }
+    static bool readinessSatisfied() { return EthernetManager::getInstance().readinessSatisfied(); }
+    static void evaluateReadiness(bool reannounce) { EthernetManager::getInstance().evaluateReadiness(reannounce); }
+    static bool connectedBit() {
+        auto& inst = EthernetManager::getInstance();
+        return (xEventGroupGetBits(inst.ethEventGroup) & EthernetManager::BIT_CONNECTED) != 0;
+    }
+    static bool gotIp4Bit() {
+        auto& inst = EthernetManager::getInstance();
+        return (xEventGroupGetBits(inst.ethEventGroup) & EthernetManager::BIT_GOT_IP4) != 0;
+    }
+
+    static EthTrafficClass classifyTraffic(const uint8_t* frame, uint32_t length) {
+        return EthernetManager::getInstance().classifyTraffic(frame, length);
+    }
+    static bool isMagicPacket(const uint8_t* frame, uint32_t length, const uint8_t* mac) {
+        return EthernetManager::isMagicPacket(frame, length, mac);
+    }
+    static const char* identifyPhy(uint16_t id1, uint16_t id2) {
+        return EthernetManager::identifyPhy(id1, id2);
+    }
+    static uint32_t nextAutoIpCandidate(uint32_t& seed) {
+        return EthernetManager::nextAutoIpCandidate(seed);
+    }
+
+    static esp_netif_t* vlanInput(uint8_t* buffer, uint32_t& length, esp_netif_t* netif) {
+        return EthernetManager::getInstance().vlanInput(buffer, length, netif);
+    }
+    static uint32_t rxVlanDropped() { return EthernetManager::getInstance().stats.rxVlanDropped; }
+};
+
+// Ethernet header with the given EtherType; the rest of the frame is zeroed
+static void fillEthernetHeader(uint8_t* frame, size_t size, uint16_t etherType) {
+    memset(frame, 0, size);
+    memset(frame, 0xFF, 6);
+    frame[12] = etherType >> 8;
+    frame[13] = etherType & 0xFF;
+}
+
 // Test advanced features
 void test_performance_metrics() {
     EthernetManager::cleanup();
@@ -197,6 +306,466 @@ void test_debug_logging_callback() {
     // This test verifies the API exists
 }
 
+void test_failover_requires_compile_flag() {
+    EthernetManager::cleanup();
+    
+    // Test builds leave ETH_ENABLE_WIFI_FAILOVER at its default of 0
+    bool enabled = EthernetManager::enableFailover("test-ssid", "test-pass");
+    TEST_ASSERT_FALSE(enabled);
+    TEST_ASSERT_TRUE(EthernetManager::getActiveUplink() == EthUplink::NONE);
+    
+    FailoverStats fo = EthernetManager::getFailoverStats();
+    TEST_ASSERT_EQUAL(0, fo.switchoverCount);
+}
+
+void test_lease_cache_requires_restore_option() {
+    EthernetManager::cleanup();
+    EthernetManager::setDhcpLeaseCache(true);
+
+    // Only lwIP's restore hook sends the REQUEST for the stored address
+#if CONFIG_LWIP_DHCP_RESTORE_LAST_IP
+    TEST_ASSERT_TRUE(EthernetManagerTest::leaseCacheEnabled());
+#else
+    TEST_ASSERT_FALSE(EthernetManagerTest::leaseCacheEnabled());
+    TEST_ASSERT_TRUE(EthernetManager::getLastError() == EthError::CONFIG_FAILED);
+#endif
+
+    EthernetManager::setDhcpLeaseCache(false);
+    TEST_ASSERT_FALSE(EthernetManagerTest::leaseCacheEnabled());
+}
+
+void test_rx_rule_token_bucket() {
+    // Classifier rule: 10 packets/s, burst of 2
+    EthernetManagerTest::RxRule rule = {};
+    rule.ratePps = 10;
+    rule.burstMilli = 2 * TokenBucket::MILLI_TOKENS;
+    rule.tokensMilli = rule.burstMilli;
+    rule.refilledUs = 0;
+
+    TEST_ASSERT_TRUE(TokenBucket::take(rule, 0));
+    TEST_ASSERT_TRUE(TokenBucket::take(rule, 0));
+    TEST_ASSERT_FALSE(TokenBucket::take(rule, 0));
+    TEST_ASSERT_FALSE(TokenBucket::take(rule, 50000));   // Half a token so far
+    TEST_ASSERT_TRUE(TokenBucket::take(rule, 100000));   // The half is carried, not lost
+    TEST_ASSERT_FALSE(TokenBucket::take(rule, 100000));
+
+    // A zero rate drops every match
+    rule.ratePps = 0;
+    TEST_ASSERT_FALSE(TokenBucket::take(rule, 10000000));
+}
+
+void test_shaper_token_bucket() {
+    // Shaper bucket: 1000 bytes/s, burst 1500
+    EthernetManagerTest::ShaperBucket bucket = {};
+    bucket.bytesPerSec = 1000;
+    bucket.burst = 1500;
+    bucket.tokens = 0;
+    bucket.refilledUs = 0;
+
+    TokenBucket::refill(bucket, 500000);
+    TEST_ASSERT_EQUAL(500, bucket.tokens);
+    TEST_ASSERT_TRUE(TokenBucket::hasTokens(bucket, 500));
+    TEST_ASSERT_FALSE(TokenBucket::hasTokens(bucket, 501));
+    TEST_ASSERT_EQUAL(100001, TokenBucket::waitUs(bucket, 600));
+
+    TokenBucket::consume(bucket, 500);
+    TEST_ASSERT_EQUAL(0, bucket.tokens);
+
+    // Refill stops at the burst size
+    TokenBucket::refill(bucket, 10000000);
+    TEST_ASSERT_EQUAL(1500, bucket.tokens);
+
+    // Unlimited buckets always pass
+    bucket.bytesPerSec = 0;
+    bucket.tokens = 0;
+    TEST_ASSERT_TRUE(TokenBucket::hasTokens(bucket, 1500));
+    TEST_ASSERT_EQUAL(0, TokenBucket::waitUs(bucket, 1500));
+}
+
+void test_classify_traffic() {
+    EthernetManager::cleanup();
+    EthernetManager::clearTrafficRules();
+    uint8_t frame[64];
+
+    // ARP and network control are CONTROL by default
+    fillEthernetHeader(frame, sizeof(frame), 0x0806);
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, sizeof(frame)) == EthTrafficClass::CONTROL);
+
+    fillEthernetHeader(frame, sizeof(frame), 0x0800);
+    frame[14] = 0x45;                   // IPv4, 20-byte header
+    frame[15] = 48 << 2;                // DSCP CS6
+    frame[23] = 17;                     // UDP
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, sizeof(frame)) == EthTrafficClass::CONTROL);
+
+    // Best effort is NORMAL until a rule matches its port
+    frame[15] = 0;
+    frame[36] = 5004 >> 8;              // UDP destination port
+    frame[37] = 5004 & 0xFF;
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, sizeof(frame)) == EthTrafficClass::NORMAL);
+    TEST_ASSERT_TRUE(EthernetManager::addTrafficRule(EthTrafficMatch::PORT, 5004, EthTrafficClass::HIGH));
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, sizeof(frame)) == EthTrafficClass::HIGH);
+
+    // Later fragments carry no ports
+    frame[20] = 0x00;
+    frame[21] = 0x10;
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, sizeof(frame)) == EthTrafficClass::NORMAL);
+
+    // Runt frames are NORMAL
+    TEST_ASSERT_TRUE(EthernetManagerTest::classifyTraffic(frame, 10) == EthTrafficClass::NORMAL);
+
+    EthernetManager::clearTrafficRules();
+}
+
+void test_magic_packet_detection() {
+    const uint8_t mac[6] = TEST_MAC_ADDRESS;
+    const uint8_t other[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    uint8_t frame[14 + 8 + 6 + 16 * 6];
+
+    // UDP-style offset: the sync stream need not start the payload
+    fillEthernetHeader(frame, sizeof(frame), 0x0842);
+    uint8_t* magic = frame + 14 + 8;
+    memset(magic, 0xFF, 6);
+    for (int i = 0; i < 16; i++) {
+        memcpy(magic + 6 + i * 6, mac, 6);
+    }
+
+    TEST_ASSERT_TRUE(EthernetManagerTest::isMagicPacket(frame, sizeof(frame), mac));
+    TEST_ASSERT_FALSE(EthernetManagerTest::isMagicPacket(frame, sizeof(frame), other));
+    TEST_ASSERT_FALSE(EthernetManagerTest::isMagicPacket(frame, sizeof(frame) - 1, mac));
+
+    // Fifteen repeats are not enough
+    memcpy(magic + 6 + 15 * 6, other, 6);
+    TEST_ASSERT_FALSE(EthernetManagerTest::isMagicPacket(frame, sizeof(frame), mac));
+}
+
+void test_identify_phy() {
+    // The revision nibble of ID2 is ignored
+    TEST_ASSERT_EQUAL_STRING("LAN8720A", EthernetManagerTest::identifyPhy(0x0007, 0xC0F1));
+    TEST_ASSERT_EQUAL_STRING("LAN8720A", EthernetManagerTest::identifyPhy(0x0007, 0xC0FF));
+    TEST_ASSERT_EQUAL_STRING("IP101", EthernetManagerTest::identifyPhy(0x0243, 0x0C54));
+    TEST_ASSERT_EQUAL_STRING("unknown", EthernetManagerTest::identifyPhy(0x1234, 0x5678));
+}
+
+void test_vlan_input_strips_tag() {
+    EthernetManager::cleanup();
+    TEST_ASSERT_TRUE(EthernetManager::setVlan(100));
+
+    // Only compared and returned, never dereferenced
+    int dummy = 0;
+    esp_netif_t* netif = reinterpret_cast<esp_netif_t*>(&dummy);
+    uint8_t frame[64];
+
+    fillEthernetHeader(frame, sizeof(frame), 0x8100);
+    frame[14] = 0x00;                   // PCP 0, VID 100
+    frame[15] = 100;
+    frame[16] = 0x08;                   // Inner EtherType IPv4
+    frame[17] = 0x00;
+    frame[18] = 0x45;
+    uint32_t length = sizeof(frame);
+
+    TEST_ASSERT_TRUE(EthernetManagerTest::vlanInput(frame, length, netif) == netif);
+    TEST_ASSERT_EQUAL(sizeof(frame) - 4, length);
+    TEST_ASSERT_EQUAL_HEX8(0x08, frame[12]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, frame[13]);
+    TEST_ASSERT_EQUAL_HEX8(0x45, frame[14]);
+    TEST_ASSERT_EQUAL(1, EthernetManager::getVlanStats(100).rxFrames);
+
+    // Frames for a VLAN without an interface are dropped untouched
+    uint32_t dropped = EthernetManagerTest::rxVlanDropped();
+    fillEthernetHeader(frame, sizeof(frame), 0x8100);
+    frame[15] = 200;
+    length = sizeof(frame);
+    TEST_ASSERT_NULL(EthernetManagerTest::vlanInput(frame, length, netif));
+    TEST_ASSERT_EQUAL(sizeof(frame), length);
+    TEST_ASSERT_EQUAL(dropped + 1, EthernetManagerTest::rxVlanDropped());
+
+    EthernetManager::cleanup();
+}
+
+void test_autoip_candidates_in_range() {
+    // RFC 3927 excludes the first and last /24 of 169.254/16
+    uint32_t seed = 0xBEEFFEED;
+    for (int i = 0; i < 2000; i++) {
+        IPAddress candidate(EthernetManagerTest::nextAutoIpCandidate(seed));
+        TEST_ASSERT_EQUAL(169, candidate[0]);
+        TEST_ASSERT_EQUAL(254, candidate[1]);
+        TEST_ASSERT_GREATER_OR_EQUAL(1, candidate[2]);
+        TEST_ASSERT_LESS_OR_EQUAL(254, candidate[2]);
+    }
+
+    // The same seed (MAC) reclaims the same address
+    uint32_t a = 0x12345678, b = 0x12345678;
+    TEST_ASSERT_EQUAL(EthernetManagerTest::nextAutoIpCandidate(a), EthernetManagerTest::nextAutoIpCandidate(b));
+}
+
+void test_backoff_delay_policies() {
+    EthernetManager::cleanup();
+    EthernetManager::setAutoReconnect(false, 0, 1000, 8000);
+
+    // Exponential: initial delay, then doubling up to the maximum
+    EthernetManager::setReconnectBackoff(EthBackoffPolicy::EXPONENTIAL);
+    TEST_ASSERT_EQUAL(1000, EthernetManagerTest::nextBackoffDelay(0, 0));
+    TEST_ASSERT_EQUAL(2000, EthernetManagerTest::nextBackoffDelay(1, 1000));
+    TEST_ASSERT_EQUAL(8000, EthernetManagerTest::nextBackoffDelay(4, 8000));
+
+    // Full jitter: uniform below min(initial << attempts, max), never zero
+    EthernetManager::setReconnectBackoff(EthBackoffPolicy::FULL_JITTER);
+    for (uint8_t attempt = 0; attempt < 8; attempt++) {
+        uint32_t delay = EthernetManagerTest::nextBackoffDelay(attempt, 0);
+        uint32_t ceiling = (1000u << attempt) < 8000u ? (1000u << attempt) : 8000u;
+        TEST_ASSERT_GREATER_OR_EQUAL(1, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(ceiling, delay);
+    }
+
+    // Decorrelated jitter: between the initial delay and three times the last one
+    EthernetManager::setReconnectBackoff(EthBackoffPolicy::DECORRELATED_JITTER);
+    for (int i = 0; i < 50; i++) {
+        uint32_t delay = EthernetManagerTest::nextBackoffDelay(1, 2000);
+        TEST_ASSERT_GREATER_OR_EQUAL(1000, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(6000, delay);
+    }
+
+    EthernetManager::setReconnectBackoff(EthBackoffPolicy::EXPONENTIAL);
+}
+
+void test_flap_penalty_decays_by_half_life() {
+    EthernetManager::cleanup();
+    EthernetManager::setFlapDamping(true, 1000, 2500, 750);
+
+    // One half-life halves the penalty, two quarter it
+    TEST_ASSERT_FLOAT_WITHIN(20.0f, 500.0f, EthernetManagerTest::decayFlapPenalty(1000.0f, 1000));
+    TEST_ASSERT_FLOAT_WITHIN(20.0f, 250.0f, EthernetManagerTest::decayFlapPenalty(1000.0f, 2000));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 1000.0f, EthernetManagerTest::decayFlapPenalty(1000.0f, 0));
+
+    EthernetManager::setFlapDamping(false);
+}
+
+void test_record_flap_suppresses_at_threshold() {
+    EthernetManager::cleanup();
+    EthernetManager::setFlapDamping(true, 60000, 2500, 750);
+    EthernetManagerTest::decayFlapPenalty(0.0f, 0);
+    FlapStats before = EthernetManager::getFlapStats();
+
+    // Each flap adds ETH_FLAP_PENALTY; the third crosses 2500
+    EthernetManagerTest::recordFlap();
+    EthernetManagerTest::recordFlap();
+    TEST_ASSERT_FALSE(EthernetManagerTest::linkSuppressed());
+    EthernetManagerTest::recordFlap();
+    TEST_ASSERT_TRUE(EthernetManagerTest::linkSuppressed());
+
+    FlapStats after = EthernetManager::getFlapStats();
+    TEST_ASSERT_EQUAL(before.flapCount + 3, after.flapCount);
+    TEST_ASSERT_EQUAL(before.suppressCount + 1, after.suppressCount);
+
+    // The penalty is capped
+    for (int i = 0; i < 10; i++) {
+        EthernetManagerTest::recordFlap();
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, (float)ETH_FLAP_MAX_PENALTY, EthernetManagerTest::flapPenalty());
+
+    // cleanup() drops the suppression and its timer
+    EthernetManager::cleanup();
+    TEST_ASSERT_FALSE(EthernetManagerTest::linkSuppressed());
+    EthernetManager::setFlapDamping(false);
+}
+
+void test_link_hold_resumes_held_address() {
+    EthernetManager::cleanup();
+    EthernetManager::setAutoReconnect(false);
+    EthernetManager::setLinkHoldGrace(5000);
+    EthResult<void> result = EthernetManager::initializeAsync();
+    TEST_ASSERT_TRUE(result.isOk());
+    BlipStats before = EthernetManager::getBlipStats();
+
+    // A blip after the trust window holds the address instead of disconnecting
+    uint32_t ip = (uint32_t)TEST_STATIC_IP;
+    EthernetManagerTest::markConnected(ETH_CONNECTION_TRUST_WINDOW_MS + 1000);
+    EthernetManagerTest::holdAddress(ip, EthAddressSource::STATIC);
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED);
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::LINK_DOWN_HOLDING);
+    TEST_ASSERT_FALSE(EthernetManagerTest::connectedBit());
+
+    // Link back; the reposted address resumes without a new connection
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_CONNECTED);
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::LINK_DOWN_HOLDING);
+    TEST_ASSERT_TRUE(EthernetManagerTest::consumeHeldAddress(ip));
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::CONNECTED);
+    TEST_ASSERT_TRUE(EthernetManagerTest::connectedBit());
+
+    // A different address ends the hold and is announced as a new connection
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED);
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::LINK_DOWN_HOLDING);
+    TEST_ASSERT_FALSE(EthernetManagerTest::consumeHeldAddress((uint32_t)TEST_GATEWAY));
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::OBTAINING_IP);
+
+    BlipStats after = EthernetManager::getBlipStats();
+    TEST_ASSERT_EQUAL(before.holds + 2, after.holds);
+    TEST_ASSERT_EQUAL(before.resumed + 1, after.resumed);
+    TEST_ASSERT_EQUAL(before.expired + 1, after.expired);
+
+    EthernetManager::setLinkHoldGrace(0);
+    EthernetManager::cleanup();
+}
+
+void test_foreign_netif_events_ignored() {
+    EthernetManager::cleanup();
+    EthernetManager::setAutoReconnect(false);
+    EthResult<void> result = EthernetManager::initializeAsync();
+    TEST_ASSERT_TRUE(result.isOk());
+
+    // Stands in for a second Ethernet interface (e.g. an SPI MAC)
+    uint32_t other = 0;
+    esp_netif_t* foreignNetif = reinterpret_cast<esp_netif_t*>(&other);
+    esp_eth_handle_t foreignHandle = reinterpret_cast<esp_eth_handle_t>(&other);
+
+    // Its address does not make us ready
+    EthernetManagerTest::setAddressBits(false, false);
+    EthernetManagerTest::ipEvent(IP_EVENT_ETH_GOT_IP, foreignNetif, (uint32_t)TEST_STATIC_IP);
+    TEST_ASSERT_FALSE(EthernetManagerTest::gotIp4Bit());
+    TEST_ASSERT_FALSE(EthernetManagerTest::connectedBit());
+
+    // Losing it does not take us down
+    EthernetManagerTest::markConnected(ETH_CONNECTION_TRUST_WINDOW_MS + 1000);
+    EthernetManagerTest::setAddressBits(true, false);
+    EthernetManagerTest::ipEvent(IP_EVENT_ETH_LOST_IP, foreignNetif, 0);
+    TEST_ASSERT_TRUE(EthernetManagerTest::gotIp4Bit());
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::CONNECTED);
+
+    // Neither does its carrier loss, once our driver handle is known
+    if (EthBackend::handle()) {
+        EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED, foreignHandle);
+        TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::CONNECTED);
+        TEST_ASSERT_TRUE(EthernetManagerTest::connectedBit());
+    }
+
+    EthernetManager::cleanup();
+}
+
+void test_ready_policy_address_bits() {
+    EthernetManager::cleanup();
+    EthResult<void> result = EthernetManager::initializeAsync();
+    TEST_ASSERT_TRUE(result.isOk());
+
+    // Readiness for {none, IPv4, IPv6, both} under each policy
+    struct {
+        EthIpReadyPolicy policy;
+        bool ready[4];
+    } cases[] = {
+        {EthIpReadyPolicy::IPV4,   {false, true,  false, true}},
+        {EthIpReadyPolicy::IPV6,   {false, false, true,  true}},
+        {EthIpReadyPolicy::EITHER, {false, true,  true,  true}},
+        {EthIpReadyPolicy::BOTH,   {false, false, false, true}},
+    };
+    for (const auto& c : cases) {
+        EthernetManagerTest::setReadyPolicy(c.policy);
+        for (int bits = 0; bits < 4; bits++) {
+            EthernetManagerTest::setAddressBits(bits & 1, bits & 2);
+            TEST_ASSERT_EQUAL(c.ready[bits], EthernetManagerTest::readinessSatisfied());
+        }
+    }
+
+    // A routable IPv6 address alone connects under EITHER
+    EthernetManagerTest::setReadyPolicy(EthIpReadyPolicy::EITHER);
+    EthernetManagerTest::setAddressBits(false, true);
+    EthernetManagerTest::evaluateReadiness(false);
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::CONNECTED);
+    TEST_ASSERT_TRUE(EthernetManagerTest::connectedBit());
+
+    EthernetManager::cleanup();
+}
+
+void test_flap_inside_trust_window_reports_down() {
+    EthernetManager::cleanup();
+    EthernetManager::setAutoReconnect(false);
+    EthernetManager::setFlapDamping(true, 60000, 2500, 750);
+    EthResult<void> result = EthernetManager::initializeAsync();
+    TEST_ASSERT_TRUE(result.isOk());
+    EthernetManagerTest::decayFlapPenalty(0.0f, 0);
+
+    static uint32_t disconnects;
+    disconnects = 0;
+    EthernetManager::setDisconnectedCallback([](uint32_t) { disconnects++; });
+
+    // Bounces inside the trust window are ignored until damping kicks in
+    EthernetManagerTest::markConnected();
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED);
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED);
+    TEST_ASSERT_FALSE(EthernetManagerTest::linkSuppressed());
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::CONNECTED);
+
+    // The third crosses the threshold and takes the link down
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_DISCONNECTED);
+    TEST_ASSERT_TRUE(EthernetManagerTest::linkSuppressed());
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::LINK_DOWN);
+    TEST_ASSERT_FALSE(EthernetManagerTest::connectedBit());
+    TEST_ASSERT_EQUAL(1, disconnects);
+
+    // Carrier back while suppressed: still down
+    EthernetManagerTest::ethEvent(ETHERNET_EVENT_CONNECTED);
+    TEST_ASSERT_TRUE(EthernetManager::getConnectionState() == EthConnectionState::LINK_DOWN);
+
+    EthernetManager::setDisconnectedCallback(nullptr);
+    EthernetManager::cleanup();
+    EthernetManager::setFlapDamping(false);
+}
+
+void test_config_keeps_custom_backoff() {
+    EthernetManager::cleanup();
+    EthernetManager::setAutoReconnect(false, 0, 1000, 8000);
+    EthernetManager::setReconnectBackoff([](uint8_t attempt, uint32_t previousDelayMs) -> uint32_t {
+        return 1234;
+    });
+
+    // A config without withReconnectBackoff() leaves the function in place
+    EthernetConfig config;
+    config.withHostname(TEST_HOSTNAME);
+    EthResult<void> result = EthernetManager::initializeAsync(config);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_TRUE(EthernetManagerTest::backoffPolicy() == EthBackoffPolicy::CUSTOM);
+    TEST_ASSERT_EQUAL(1234, EthernetManagerTest::nextBackoffDelay(1, 1000));
+
+    // An explicit policy still replaces it
+    EthernetManager::cleanup();
+    EthernetConfig jitter;
+    jitter.withHostname(TEST_HOSTNAME).withReconnectBackoff(EthBackoffPolicy::FULL_JITTER);
+    result = EthernetManager::initializeAsync(jitter);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_TRUE(EthernetManagerTest::backoffPolicy() == EthBackoffPolicy::FULL_JITTER);
+
+    EthernetManager::cleanup();
+    EthernetManager::setReconnectBackoff(nullptr);
+}
+
+void test_config_keeps_runtime_settings() {
+    EthernetManager::cleanup();
+
+    // Set at runtime, then a config that does not mention them
+    EthernetManager::setFlapDamping(true, 10000, 2500, 750);
+    EthernetManager::setLinkHoldGrace(1234);
+    EthernetManager::setSocketAbortOnDisconnect(!ETH_ABORT_SOCKETS_ON_DISCONNECT);
+
+    EthernetConfig config;
+    config.withHostname(TEST_HOSTNAME);
+    EthResult<void> result = EthernetManager::initializeAsync(config);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_TRUE(EthernetManagerTest::flapDampingEnabled());
+    TEST_ASSERT_EQUAL(1234, EthernetManagerTest::linkHoldGraceMs());
+    TEST_ASSERT_TRUE(EthernetManagerTest::socketAbortEnabled() == !ETH_ABORT_SOCKETS_ON_DISCONNECT);
+
+    // Builder calls still win
+    EthernetManager::cleanup();
+    EthernetConfig explicitConfig;
+    explicitConfig.withHostname(TEST_HOSTNAME).withFlapDamping(false).withLinkHoldGrace(500);
+    result = EthernetManager::initializeAsync(explicitConfig);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_FALSE(EthernetManagerTest::flapDampingEnabled());
+    TEST_ASSERT_EQUAL(500, EthernetManagerTest::linkHoldGraceMs());
+
+    EthernetManager::cleanup();
+    EthernetManager::setLinkHoldGrace(ETH_LINK_HOLD_GRACE_MS);
+    EthernetManager::setSocketAbortOnDisconnect(ETH_ABORT_SOCKETS_ON_DISCONNECT);
+}
+
 // Test runner
 void setup() {
     Serial.begin(115200);
@@ -215,6 +784,24 @@ void setup() {
     RUN_TEST(test_link_status_check);
     RUN_TEST(test_diagnostics_dump);
     RUN_TEST(test_debug_logging_callback);
+    RUN_TEST(test_failover_requires_compile_flag);
+    RUN_TEST(test_lease_cache_requires_restore_option);
+    RUN_TEST(test_rx_rule_token_bucket);
+    RUN_TEST(test_shaper_token_bucket);
+    RUN_TEST(test_classify_traffic);
+    RUN_TEST(test_magic_packet_detection);
+    RUN_TEST(test_identify_phy);
+    RUN_TEST(test_vlan_input_strips_tag);
+    RUN_TEST(test_autoip_candidates_in_range);
+    RUN_TEST(test_backoff_delay_policies);
+    RUN_TEST(test_config_keeps_custom_backoff);
+    RUN_TEST(test_config_keeps_runtime_settings);
+    RUN_TEST(test_flap_penalty_decays_by_half_life);
+    RUN_TEST(test_record_flap_suppresses_at_threshold);
+    RUN_TEST(test_flap_inside_trust_window_reports_down);
+    RUN_TEST(test_ready_policy_address_bits);
+    RUN_TEST(test_link_hold_resumes_held_address);
+    RUN_TEST(test_foreign_netif_events_ignored);
     
     UNITY_END();
 }